@@ -0,0 +1,262 @@
+﻿/*
+  ==============================================================================
+    Main.cpp
+    FdnBenchmark – courbes de montée en charge de la FDN (lignes x workers)
+                   + audit allocations / verrous du thread audio (--audit)
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/FdnReverb.h"
+#include "../../Source/PluginProcessor.h"
+
+//==============================================================================
+// Temps de calcul moyen par bloc pour une configuration donnée.
+// numStarted : workers réellement lancés (threads temps réel refusés = moins)
+//
+// Les blocs sont cadencés comme un vrai callback audio (un bloc par période) :
+// entre deux blocs les workers s'endorment et le temps de réveil est compté.
+//==============================================================================
+
+static double measureMicrosPerBlock(int numLines, int numWorkers, double sampleRate,
+    int blockSize, int numBlocks, int& numStarted)
+{
+    FdnReverb reverb;
+    reverb.prepare(sampleRate);
+    reverb.startWorkers(numWorkers);
+    numStarted = reverb.getNumWorkers();
+
+    FdnReverb::Parameters params;
+    params.numLines = numLines;
+    params.roomSize = 0.8f;
+    params.wetLevel = 1.0f;
+    params.dryLevel = 0.0f;
+    reverb.setParameters(params);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::Random rng(1234);
+
+    auto fillNoise = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(ch, i, rng.nextFloat() * 2.0f - 1.0f);
+        };
+
+    const auto blockPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(blockSize / sampleRate));
+    auto nextBlock = std::chrono::steady_clock::now();
+
+    double total = 0.0;
+
+    // 50 blocs de chauffe (caches), puis mesure
+    for (int b = -50; b < numBlocks; ++b)
+    {
+        nextBlock += blockPeriod;
+        std::this_thread::sleep_until(nextBlock);
+
+        fillNoise();
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        reverb.processStereo(buffer.getWritePointer(0), buffer.getWritePointer(1), blockSize);
+
+        if (b >= 0)
+            total += juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    reverb.stopWorkers();
+    return 1000.0 * total / numBlocks;
+}
+
+//==============================================================================
+// Audit : tous les modes, toutes les densités FDN, balayage de chaque
+// paramètre et rappel d'états différents, processBlock sous surveillance.
+// Code de sortie 1 si une allocation ou un verrou a été vu sur le thread audio,
+// 3 si aucun worker FDN n'a tourné (chemin des workers non audité).
+//==============================================================================
+
+static int runAudit()
+{
+   #if SIMPLEREVERB_AUDIO_THREAD_AUDIT
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+
+    SimpleReverbAudioProcessor processor;
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    juce::Random rng(42);
+
+    auto process = [&](int numBlocks)
+        {
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < blockSize; ++i)
+                        buffer.setSample(ch, i, rng.nextFloat() * 2.0f - 1.0f);
+
+                processor.processBlock(buffer, midi);
+            }
+        };
+
+    auto setParam = [&](const char* id, int choiceIndex, int numChoices)
+        {
+            if (auto* p = processor.apvts.getParameter(id))
+                p->setValueNotifyingHost((float)choiceIndex / (float)(numChoices - 1));
+        };
+
+    // Modes DSP 0 = Delay, 1 = Reverb, 2 = Multi-Tap ("mode" + "delayType")
+    auto setMode = [&](int mode)
+        {
+            setParam("mode", mode == 1 ? 1 : 0, 2);
+            setParam("delayType", mode == 2 ? 1 : 0, 2);
+        };
+
+    const int numModes = 3;
+
+    // Etat courant modifié, rechargé par setStateInformation, puis le fondu
+    // vers lui est joué en entier (50 ms)
+    auto recall = [&](int mode, int lines, int saturation, float delayMs)
+        {
+            auto state = processor.apvts.copyState();
+
+            auto setValue = [&state](const char* id, float value)
+                {
+                    state.getChildWithProperty("id", id).setProperty("value", value, nullptr);
+                };
+
+            setValue("mode", mode == 1 ? 1.0f : 0.0f);
+            setValue("delayType", mode == 2 ? 1.0f : 0.0f);
+            setValue("fdnLines", (float)lines);
+            setValue("saturation", (float)saturation);
+            setValue("delayTimeMs", delayMs);
+
+            juce::MemoryBlock data;
+            juce::AudioProcessor::copyXmlToBinary(*state.createXml(), data);
+            processor.setStateInformation(data.getData(), (int)data.getSize());
+            process(20);
+        };
+    const int numLineCounts = FdnReverb::getLineCountNames().size();
+
+    for (int lines = 0; lines < numLineCounts; ++lines)
+    {
+        // prepareToPlay lance les workers correspondant à la densité choisie
+        setParam("fdnLines", lines, numLineCounts);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        for (int mode = 0; mode < numModes; ++mode)
+        {
+            setMode(mode);
+            process(20);
+
+            // Balayage de chaque paramètre, puis retour à sa valeur par défaut
+            for (auto* p : processor.getParameters())
+            {
+                for (int step = 0; step <= 4; ++step)
+                {
+                    p->setValueNotifyingHost((float)step / 4.0f);
+                    process(2);
+                }
+
+                p->setValueNotifyingHost(p->getDefaultValue());
+            }
+
+            setParam("fdnLines", lines, numLineCounts);
+            setMode(mode);
+            process(2);
+
+            // Rappels d'états différents pendant la lecture : changement de
+            // mode (fondu par le silence), de densité (reset de la FDN, relance
+            // des workers), de saturation (bascule de chemin) et de delay
+            const int otherMode = (mode + 1) % numModes;
+            const int otherLines = (lines + 1) % numLineCounts;
+
+            recall(otherMode, otherLines, 2, 120.0f);
+            recall(mode, lines, 1, 600.0f);
+            recall(mode, otherLines, 0, 600.0f);
+            recall(mode, lines, 0, 350.0f);
+        }
+
+        processor.releaseResources();
+    }
+
+    const int numRecords = AudioThreadAudit::getNumRecords();
+
+    for (int i = 0; i < numRecords; ++i)
+        std::cout << AudioThreadAudit::describe(AudioThreadAudit::getRecord(i)) << std::endl;
+
+    std::cout << "# audit : " << numRecords + AudioThreadAudit::getNumDropped()
+              << " allocation(s) / verrou(s) sur le thread audio" << std::endl;
+
+    if (numRecords > 0)
+        return 1;
+
+    // Le thread audio compte pour un : sans autre thread, aucun groupe FDN n'a
+    // été pris par un worker (threads temps réel refusés, ex. CI sans droits,
+    // ou machine à un seul coeur)
+    const int numThreads = AudioThreadAudit::getNumAuditedThreads();
+    std::cout << "# audit : " << numThreads << " thread(s) audite(s)" << std::endl;
+
+    if (numThreads < 2)
+    {
+        std::cout << "# aucun worker FDN lance (threads temps reel refuses par l'OS ou un seul coeur) : "
+                     "chemin des workers non audite" << std::endl;
+        return 3;
+    }
+
+    return 0;
+   #else
+    std::cout << "# audit indisponible : compiler avec SIMPLEREVERB_AUDIO_THREAD_AUDIT=1 (config Debug)" << std::endl;
+    return 2;
+   #endif
+}
+
+//==============================================================================
+// Usage : FdnBenchmark [--audit] [tailleBloc] [nbBlocs]
+// Sortie CSV : lines,workers,us_per_block,cpu_percent
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && juce::String(argv[1]) == "--audit")
+        return runAudit();
+
+    const double sampleRate = 48000.0;
+    const int blockSize = argc > 1 ? juce::jmax(16, juce::String(argv[1]).getIntValue()) : 128;
+    const int numBlocks = argc > 2 ? juce::jmax(10, juce::String(argv[2]).getIntValue()) : 1000;
+
+    const int maxWorkers = juce::jmin(FdnReverb::maxLines / FdnReverb::linesPerGroup - 1,
+        juce::SystemStats::getNumCpus() - 1);
+
+    const double blockMicros = 1.0e6 * blockSize / sampleRate;
+
+    std::cout << "# FDN @ " << sampleRate << " Hz, blocs de " << blockSize
+              << " echantillons (" << blockMicros << " us)" << std::endl;
+    std::cout << "lines,workers,us_per_block,cpu_percent" << std::endl;
+
+    for (int linesIndex = 0; linesIndex < FdnReverb::getLineCountNames().size(); ++linesIndex)
+    {
+        const int numLines = FdnReverb::lineCountFromIndex(linesIndex);
+
+        for (int workers = 0; workers <= maxWorkers; ++workers)
+        {
+            int started = 0;
+            const double us = measureMicrosPerBlock(numLines, workers, sampleRate, blockSize, numBlocks, started);
+
+            if (started < workers)
+            {
+                std::cout << "# " << workers << " worker(s) demandes, " << started
+                          << " lance(s) : threads temps reel refuses par l'OS" << std::endl;
+                break;
+            }
+
+            std::cout << numLines << "," << started << "," << us << ","
+                      << 100.0 * us / blockMicros << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+﻿/*
+  ==============================================================================
+    AudioThreadAudit.cpp
+    SimpleDelayReverbFDN – audit des allocations / verrous sur le thread audio
+  ==============================================================================
+*/
+
+#include "AudioThreadAudit.h"
+
+#if SIMPLEREVERB_AUDIO_THREAD_AUDIT
+
+#include <new>
+#include <cstdlib>
+#include <cerrno>
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <crtdbg.h>
+#else
+ #include <execinfo.h>
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+//==============================================================================
+// Enregistrement
+//==============================================================================
+
+namespace AudioThreadAudit
+{
+    static thread_local int audioDepth = 0;
+    static thread_local bool inHook = false;
+    static thread_local bool threadCounted = false;
+    static std::atomic<int> numAuditedThreads{ 0 };
+
+    static Record records[maxRecords];
+    static std::atomic<int> numWritten{ 0 };
+    static std::atomic<int> numDropped{ 0 };
+
+    static int captureStack(void** frames, int max) noexcept
+    {
+       #if JUCE_WINDOWS
+        return (int)CaptureStackBackTrace(1, (DWORD)max, frames, nullptr);
+       #else
+        return backtrace(frames, max);
+       #endif
+    }
+
+    // Le premier appel à backtrace() charge libgcc (malloc + verrous) : on le
+    // fait au démarrage plutôt que sur le thread audio
+    static const bool stackCaptureWarmedUp = []
+        {
+            void* frames[2];
+            return captureStack(frames, 2) >= 0;
+        }();
+
+    ScopedAudioThread::ScopedAudioThread() noexcept
+    {
+        ++audioDepth;
+
+        if (!threadCounted)
+        {
+            threadCounted = true;
+            numAuditedThreads.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ScopedAudioThread::~ScopedAudioThread() noexcept { --audioDepth; }
+
+    bool isAudioThread() noexcept
+    {
+        return audioDepth > 0;
+    }
+
+    int getNumAuditedThreads() noexcept
+    {
+        return numAuditedThreads.load();
+    }
+
+    void record(Event event, size_t size) noexcept
+    {
+        if (audioDepth == 0 || inHook)
+            return;
+
+        inHook = true;
+
+        const int index = numWritten.fetch_add(1, std::memory_order_relaxed);
+
+        if (index < maxRecords)
+        {
+            auto& r = records[index];
+            r.event = event;
+            r.size = size;
+            r.numFrames = captureStack(r.frames, maxFrames);
+        }
+        else
+        {
+            numDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inHook = false;
+    }
+
+    //==========================================================================
+    int getNumRecords() noexcept
+    {
+        return juce::jmin(maxRecords, numWritten.load());
+    }
+
+    int getNumDropped() noexcept
+    {
+        return numDropped.load();
+    }
+
+    const Record& getRecord(int index) noexcept
+    {
+        return records[juce::jlimit(0, maxRecords - 1, index)];
+    }
+
+    void clear() noexcept
+    {
+        numWritten = 0;
+        numDropped = 0;
+    }
+
+    juce::String describe(const Record& r)
+    {
+        juce::String s;
+        s << (r.event == Event::allocation ? "allocation" : "lock");
+
+        if (r.event == Event::allocation)
+            s << " (" << (int)r.size << " octets)";
+
+        s << "\n";
+
+       #if JUCE_WINDOWS
+        for (int i = 0; i < r.numFrames; ++i)
+            s << "    #" << i << " 0x" << juce::String::toHexString((juce::pointer_sized_int)r.frames[i]) << "\n";
+       #else
+        if (char** symbols = backtrace_symbols(r.frames, r.numFrames))
+        {
+            for (int i = 0; i < r.numFrames; ++i)
+                s << "    #" << i << " " << symbols[i] << "\n";
+
+            ::free(symbols);
+        }
+       #endif
+
+        return s;
+    }
+}
+
+using AudioThreadAudit::Event;
+
+//==============================================================================
+// Allocations
+//==============================================================================
+
+#if defined(__GLIBC__)
+
+// glibc : on remplace la famille malloc (operator new passe par malloc).
+// noexcept : glibc déclare ces fonctions __THROW en C++
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void  __libc_free(void*);
+
+    void* malloc(size_t size) noexcept
+    {
+        AudioThreadAudit::record(Event::allocation, size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        AudioThreadAudit::record(Event::allocation, count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept
+    {
+        AudioThreadAudit::record(Event::allocation, size);
+        return __libc_realloc(ptr, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        AudioThreadAudit::record(Event::allocation, size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        AudioThreadAudit::record(Event::allocation, size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        AudioThreadAudit::record(Event::allocation, size);
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free(void* ptr) noexcept
+    {
+        __libc_free(ptr);
+    }
+}
+
+#elif JUCE_WINDOWS && defined(_DEBUG)
+
+// CRT debug : un hook voit malloc et new
+static int auditAllocHook(int allocType, void*, size_t size, int, long, const unsigned char*, int)
+{
+    if (allocType != _HOOK_FREE)
+        AudioThreadAudit::record(Event::allocation, size);
+
+    return TRUE;
+}
+
+static const auto previousAllocHook = _CrtSetAllocHook(auditAllocHook);
+
+#else
+
+// Ailleurs : operator new seulement
+void* operator new(std::size_t size)
+{
+    AudioThreadAudit::record(Event::allocation, size);
+
+    if (void* p = std::malloc(size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    AudioThreadAudit::record(Event::allocation, size);
+    return std::malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept                        { std::free(ptr); }
+void operator delete[](void* ptr) noexcept                      { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept           { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept         { std::free(ptr); }
+
+#endif
+
+//==============================================================================
+// Verrous (POSIX). Sous Windows, seules les allocations sont auditées.
+//==============================================================================
+
+#if !JUCE_WINDOWS
+
+template <typename Fn>
+static Fn resolveNext(std::atomic<Fn>& cache, const char* name) noexcept
+{
+    auto fn = cache.load(std::memory_order_acquire);
+
+    if (fn == nullptr)
+    {
+        fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+        cache.store(fn, std::memory_order_release);
+    }
+
+    return fn;
+}
+
+// Déclarées __THROWNL par glibc (noexcept en C++)
+extern "C"
+{
+    int pthread_mutex_lock(pthread_mutex_t* m) noexcept
+    {
+        static std::atomic<int (*)(pthread_mutex_t*)> next{ nullptr };
+        AudioThreadAudit::record(Event::lock, 0);
+        return resolveNext(next, "pthread_mutex_lock")(m);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t* m) noexcept
+    {
+        static std::atomic<int (*)(pthread_mutex_t*)> next{ nullptr };
+        AudioThreadAudit::record(Event::lock, 0);
+        return resolveNext(next, "pthread_mutex_trylock")(m);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* l) noexcept
+    {
+        static std::atomic<int (*)(pthread_rwlock_t*)> next{ nullptr };
+        AudioThreadAudit::record(Event::lock, 0);
+        return resolveNext(next, "pthread_rwlock_rdlock")(l);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* l) noexcept
+    {
+        static std::atomic<int (*)(pthread_rwlock_t*)> next{ nullptr };
+        AudioThreadAudit::record(Event::lock, 0);
+        return resolveNext(next, "pthread_rwlock_wrlock")(l);
+    }
+}
+
+#endif
+
+#endif // SIMPLEREVERB_AUDIO_THREAD_AUDIT
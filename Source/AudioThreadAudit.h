@@ -0,0 +1,76 @@
+﻿/*
+  ==============================================================================
+    AudioThreadAudit.h
+    SimpleDelayReverbFDN – audit des allocations / verrous sur le thread audio
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Option de build debug / CI : SIMPLEREVERB_AUDIO_THREAD_AUDIT=1
+//
+// Intercepte operator new (et malloc / calloc / realloc sous glibc, le hook
+// d'allocation du CRT debug sous Windows) ainsi que pthread_mutex_lock /
+// trylock et les rwlocks POSIX. Tout appel fait dans une portée
+// SIMPLEREVERB_AUDIT_SCOPE (processBlock, groupes FDN des workers) est
+// enregistré avec sa pile d'appels, sans allouer.
+//
+// Prévu pour un exécutable (outil d'audit) : pas pour un plugin chargé dans
+// un hôte, où remplacer new / malloc toucherait tout le processus.
+// Verrous audités sous POSIX uniquement : export Linux Makefile du benchmark.
+//==============================================================================
+#ifndef SIMPLEREVERB_AUDIO_THREAD_AUDIT
+ #define SIMPLEREVERB_AUDIO_THREAD_AUDIT 0
+#endif
+
+#if SIMPLEREVERB_AUDIO_THREAD_AUDIT
+
+namespace AudioThreadAudit
+{
+    enum class Event { allocation, lock };
+
+    static constexpr int maxFrames = 32;
+    static constexpr int maxRecords = 256;
+
+    struct Record
+    {
+        Event  event = Event::allocation;
+        size_t size = 0;            // octets demandés (allocation)
+        int    numFrames = 0;
+        void*  frames[maxFrames] = {};
+    };
+
+    // Marque le thread courant comme "audio" pour la durée de la portée
+    struct ScopedAudioThread
+    {
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+    };
+
+    bool isAudioThread() noexcept;
+
+    // Nombre de threads distincts entrés au moins une fois dans une portée
+    // auditée depuis le démarrage (> 1 : des workers FDN ont été audités)
+    int getNumAuditedThreads() noexcept;
+
+    // Appelé par les hooks : n'alloue pas, ne verrouille pas
+    void record(Event event, size_t size) noexcept;
+
+    //==========================================================================
+    // Lecture des résultats (hors thread audio)
+    int getNumRecords() noexcept;        // enregistrés (plafonné à maxRecords)
+    int getNumDropped() noexcept;        // au-delà de maxRecords
+    const Record& getRecord(int index) noexcept;
+    void clear() noexcept;
+
+    // Description lisible avec symboles (alloue : hors thread audio)
+    juce::String describe(const Record& r);
+}
+
+ #define SIMPLEREVERB_AUDIT_SCOPE AudioThreadAudit::ScopedAudioThread auditScope;
+#else
+ #define SIMPLEREVERB_AUDIT_SCOPE
+#endif
@@ -0,0 +1,141 @@
+﻿/*
+  ==============================================================================
+    DecayFilterBank.h
+    SimpleDelayReverbFDN – filtres de décroissance 3 bandes (grave / médium / aigu)
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Banc de filtres placé dans la boucle de feedback.
+//
+// Chaque "voie" (une ligne de la FDN, ou un canal du delay) applique :
+//   gain médium  ->  étagère grave 1er ordre  ->  étagère aiguë 1er ordre
+//
+// Les gains des bandes sont dérivés d'un multiplicateur de temps de
+// décroissance (T60 bande / T60 médium) : gBande = gMedium^(1 / mult).
+//
+// Coefficients et états sont rangés voie par voie (SoA) : la boucle interne
+// de processSample() porte sur les voies, le compilateur la vectorise.
+//==============================================================================
+template <int MaxLanes>
+class DecayFilterBank
+{
+public:
+    static constexpr int maxLanes = MaxLanes;
+
+    //==========================================================================
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        updateWarping();
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::fill(std::begin(lowState), std::end(lowState), 0.0f);
+        std::fill(std::begin(highState), std::end(highState), 0.0f);
+    }
+
+    // Fréquences de transition grave/médium et médium/aigu (Hz)
+    void setCrossovers(float lowHz, float highHz)
+    {
+        lowCrossover = lowHz;
+        highCrossover = highHz;
+        updateWarping();
+    }
+
+    //==========================================================================
+    // Recalcul des coefficients : à n'appeler que lorsqu'un paramètre bouge.
+    // midGains : gain par passage dans la boucle (bande médium) pour chaque voie
+    void setGains(const float* midGains, int numLanes, float lowMult, float highMult) noexcept
+    {
+        jassert(numLanes <= MaxLanes);
+
+        const float invLow = 1.0f / juce::jmax(0.01f, lowMult);
+        const float invHigh = 1.0f / juce::jmax(0.01f, highMult);
+
+        for (int n = 0; n < numLanes; ++n)
+        {
+            const float g = midGains[n];
+
+            if (g <= 0.0f)
+            {
+                lowB0[n] = lowB1[n] = lowA1[n] = 0.0f;
+                highB0[n] = 1.0f;
+                highB1[n] = highA1[n] = 0.0f;
+                continue;
+            }
+
+            const float gLow = std::pow(g, invLow) / g;    // gain DC relatif
+            const float gHigh = std::pow(g, invHigh) / g;  // gain Nyquist relatif
+
+            // Étagère grave (bilinéaire) : H(1) = gLow, H(-1) = 1, gain médium intégré
+            {
+                const float k = kLow;
+                const float a0 = 1.0f / (k + 1.0f);
+                lowB0[n] = g * (k * gLow + 1.0f) * a0;
+                lowB1[n] = g * (k * gLow - 1.0f) * a0;
+                lowA1[n] = (k - 1.0f) * a0;
+            }
+
+            // Étagère aiguë (bilinéaire) : H(1) = 1, H(-1) = gHigh
+            {
+                const float k = kHigh;
+                const float a0 = 1.0f / (k + 1.0f);
+                highB0[n] = (gHigh + k) * a0;
+                highB1[n] = (k - gHigh) * a0;
+                highA1[n] = (k - 1.0f) * a0;
+            }
+        }
+    }
+
+    //==========================================================================
+    // Filtre un échantillon par voie, sur place (x[0 .. numLanes-1])
+    void processSample(float* x, int numLanes) noexcept
+    {
+        processSample(x, 0, numLanes);
+    }
+
+    // Variante sur une plage de voies [firstLane, firstLane + numLanes)
+    void processSample(float* x, int firstLane, int numLanes) noexcept
+    {
+        const int end = firstLane + numLanes;
+
+        for (int n = firstLane; n < end; ++n)
+        {
+            const float in = x[n];
+
+            const float y1 = lowB0[n] * in + lowState[n];
+            lowState[n] = lowB1[n] * in - lowA1[n] * y1;
+
+            const float y2 = highB0[n] * y1 + highState[n];
+            highState[n] = highB1[n] * y1 - highA1[n] * y2;
+
+            x[n] = y2;
+        }
+    }
+
+private:
+    //==========================================================================
+    void updateWarping() noexcept
+    {
+        const float nyquist = (float)sampleRate * 0.49f;
+        kLow = std::tan(juce::MathConstants<float>::pi * juce::jmin(lowCrossover, nyquist) / (float)sampleRate);
+        kHigh = std::tan(juce::MathConstants<float>::pi * juce::jmin(highCrossover, nyquist) / (float)sampleRate);
+    }
+
+    double sampleRate = 44100.0;
+    float lowCrossover = 250.0f;
+    float highCrossover = 3500.0f;
+    float kLow = 0.0f, kHigh = 0.0f;
+
+    // Coefficients (TDF-II, 1er ordre) et états, une case par voie
+    alignas(16) float lowB0[MaxLanes] = {}, lowB1[MaxLanes] = {}, lowA1[MaxLanes] = {};
+    alignas(16) float highB0[MaxLanes] = {}, highB1[MaxLanes] = {}, highA1[MaxLanes] = {};
+    alignas(16) float lowState[MaxLanes] = {}, highState[MaxLanes] = {};
+};
@@ -0,0 +1,237 @@
+﻿/*
+  ==============================================================================
+    DspConfig.h
+    SimpleDelayReverbFDN – configuration DSP immuable + échange temps réel
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MultiTapDelay.h"
+#include "FdnReverb.h"
+
+//==============================================================================
+// Instantané de tous les paramètres utilisés par le DSP.
+// Construit hors thread audio lors d'un chargement d'état / preset.
+//==============================================================================
+struct DspConfig
+{
+    int   mode = 0;            // 0 = Delay, 1 = Reverb, 2 = Multi-Tap (cf. modeFromParameters)
+    float delayTimeMs = 350.0f;
+
+    // Fondu entre deux temps de delay (chargement d'état) : le delay lit aux
+    // deux positions, pondérées par delayCrossfade (1 = delayTimeMs seul)
+    float previousDelayTimeMs = 350.0f;
+    float delayCrossfade = 1.0f;
+
+    float feedback = 0.4f;
+    int   saturation = 0;      // 0 = Off, 1 = 2x, 2 = 4x
+    float overdrive = 0.0f;    // ajouté au feedback si saturation active
+    float wet = 0.35f;
+    float roomSize = 0.6f;
+    float width = 1.0f;        // largeur du wet (0 = mono .. 2)
+    float balance = 0.0f;      // -1 .. +1
+    float lowDecay = 1.0f;
+    float highDecay = 1.0f;
+    int   fdnLines = 0;        // index dans FdnReverb::getLineCountNames()
+
+    int tapCount = 4;
+    MultiTapDelay::Tap taps[MultiTapDelay::maxTaps];
+
+    DspConfig()
+    {
+        for (int t = 0; t < MultiTapDelay::maxTaps; ++t)
+            taps[t] = MultiTapDelay::getDefaultTap(t);
+    }
+
+    //==========================================================================
+    // Mode DSP à partir des paramètres "mode" (Delay / Reverb) et "delayType"
+    // (Single / Multi-Tap, n'agit qu'en Delay)
+    static int modeFromParameters(int modeIndex, int delayTypeIndex) noexcept
+    {
+        return (modeIndex == 0 && delayTypeIndex == 1) ? 2 : modeIndex;
+    }
+
+    //==========================================================================
+    // Lecture depuis un état APVTS sérialisé (<PARAM id=".." value=".."/>).
+    // Les paramètres absents gardent la valeur de 'fallback'.
+    static DspConfig fromState(const juce::ValueTree& state, const DspConfig& fallback)
+    {
+        auto read = [&state](const juce::String& id, float def)
+            {
+                auto child = state.getChildWithProperty("id", id);
+                return child.isValid() ? (float)child.getProperty("value", def) : def;
+            };
+
+        DspConfig c;
+        c.mode = modeFromParameters((int)read("mode", fallback.mode == 1 ? 1.0f : 0.0f),
+                                    (int)read("delayType", fallback.mode == 2 ? 1.0f : 0.0f));
+        c.delayTimeMs = read("delayTimeMs", fallback.delayTimeMs);
+        c.feedback = read("feedback", fallback.feedback);
+        c.saturation = (int)read("saturation", (float)fallback.saturation);
+        c.overdrive = read("overdrive", fallback.overdrive);
+        c.wet = read("wet", fallback.wet);
+        c.roomSize = read("roomSize", fallback.roomSize);
+        c.width = read("width", fallback.width);
+        c.balance = read("balance", fallback.balance);
+        c.lowDecay = read("lowDecay", fallback.lowDecay);
+        c.highDecay = read("highDecay", fallback.highDecay);
+        c.fdnLines = (int)read("fdnLines", (float)fallback.fdnLines);
+        c.tapCount = (int)read("tapCount", (float)fallback.tapCount);
+
+        for (int t = 0; t < MultiTapDelay::maxTaps; ++t)
+        {
+            const auto& f = fallback.taps[t];
+            c.taps[t].division = (int)read(MultiTapDelay::paramId(t, "Division"), (float)f.division);
+            c.taps[t].gain = read(MultiTapDelay::paramId(t, "Gain"), f.gain);
+            c.taps[t].pan = read(MultiTapDelay::paramId(t, "Pan"), f.pan);
+            c.taps[t].feedback = read(MultiTapDelay::paramId(t, "Feedback"), f.feedback);
+        }
+
+        return c;
+    }
+
+    //==========================================================================
+    // Interpolation a -> b (t = 0..1). Rien de discret ne bascule en place :
+    //  - temps de delay : fondu entre les lectures aux deux positions
+    //  - mode, lignes FDN, divisions des taps : le wet passe par 0 à
+    //    mi-parcours et la bascule se fait là, sans clic
+    //  - saturation : bascule à mi-parcours, FeedbackSaturator fond lui-même
+    //    l'ancien et le nouveau chemin
+    static DspConfig morph(const DspConfig& a, const DspConfig& b, float t) noexcept
+    {
+        auto lerp = [t](float x, float y) { return x + (y - x) * t; };
+
+        DspConfig c;
+        c.delayTimeMs = b.delayTimeMs;
+        c.previousDelayTimeMs = a.delayTimeMs;
+        c.delayCrossfade = t;
+
+        c.feedback = lerp(a.feedback, b.feedback);
+        c.overdrive = lerp(a.overdrive, b.overdrive);
+        c.roomSize = lerp(a.roomSize, b.roomSize);
+        c.width = lerp(a.width, b.width);
+        c.balance = lerp(a.balance, b.balance);
+        c.lowDecay = lerp(a.lowDecay, b.lowDecay);
+        c.highDecay = lerp(a.highDecay, b.highDecay);
+
+        c.mode = t < 0.5f ? a.mode : b.mode;
+        c.fdnLines = t < 0.5f ? a.fdnLines : b.fdnLines;
+        c.saturation = t < 0.5f ? a.saturation : b.saturation;
+
+        // Bascule discrète audible dans le(s) mode(s) joué(s) ?
+        const bool reverbPlays = a.mode == 1 || b.mode == 1;
+        const bool tapsPlay = a.mode == 2 || b.mode == 2;
+
+        bool switchThroughSilence = a.mode != b.mode || (reverbPlays && a.fdnLines != b.fdnLines);
+
+        for (int i = 0; tapsPlay && i < juce::jmax(a.tapCount, b.tapCount); ++i)
+            switchThroughSilence = switchThroughSilence || a.taps[i].division != b.taps[i].division;
+
+        if (switchThroughSilence)
+            c.wet = t < 0.5f ? a.wet * (1.0f - 2.0f * t) : b.wet * (2.0f * t - 1.0f);
+        else
+            c.wet = lerp(a.wet, b.wet);
+
+        // Taps : un tap inactif compte comme un gain nul, la division bascule
+        // à mi-parcours
+        c.tapCount = juce::jmax(a.tapCount, b.tapCount);
+
+        for (int i = 0; i < MultiTapDelay::maxTaps; ++i)
+        {
+            const auto& ta = a.taps[i];
+            const auto& tb = b.taps[i];
+            auto& tc = c.taps[i];
+
+            tc.division = t < 0.5f ? ta.division : tb.division;
+            tc.gain = lerp(i < a.tapCount ? ta.gain : 0.0f, i < b.tapCount ? tb.gain : 0.0f);
+            tc.pan = lerp(ta.pan, tb.pan);
+            tc.feedback = lerp(i < a.tapCount ? ta.feedback : 0.0f, i < b.tapCount ? tb.feedback : 0.0f);
+        }
+
+        return c;
+    }
+};
+
+//==============================================================================
+// Publication d'une DspConfig vers le thread audio par échange de pointeur
+// atomique. Le thread audio ne fait jamais ni new, ni delete, ni lock :
+// il récupère la config en attente et dépose l'ancienne dans une corbeille
+// vidée par le thread message (collectGarbage).
+//==============================================================================
+class DspConfigExchange
+{
+public:
+    DspConfigExchange() = default;
+
+    ~DspConfigExchange()
+    {
+        collectGarbage();
+        delete pending.exchange(nullptr);
+        delete live;
+    }
+
+    //==========================================================================
+    // Thread message : remplace la config en attente (une config jamais vue
+    // par le thread audio est libérée directement)
+    void publish(std::unique_ptr<DspConfig> config)
+    {
+        collectGarbage();
+        delete pending.exchange(config.release(), std::memory_order_acq_rel);
+    }
+
+    // Thread message : libère les configs retirées par le thread audio
+    void collectGarbage()
+    {
+        for (auto& slot : retired)
+            delete slot.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    //==========================================================================
+    // Thread audio : renvoie la nouvelle config si une a été publiée, sinon
+    // nullptr. Si la corbeille est pleine, on réessaiera au bloc suivant.
+    const DspConfig* acquire() noexcept
+    {
+        if (pending.load(std::memory_order_relaxed) == nullptr)
+            return nullptr;
+
+        std::atomic<DspConfig*>* freeSlot = nullptr;
+
+        if (live != nullptr)
+        {
+            for (auto& slot : retired)
+            {
+                if (slot.load(std::memory_order_relaxed) == nullptr)
+                {
+                    freeSlot = &slot;
+                    break;
+                }
+            }
+
+            if (freeSlot == nullptr)
+                return nullptr;
+        }
+
+        auto* next = pending.exchange(nullptr, std::memory_order_acq_rel);
+
+        if (next == nullptr)
+            return nullptr;
+
+        if (freeSlot != nullptr)
+            freeSlot->store(live, std::memory_order_release);
+
+        live = next;
+        return live;
+    }
+
+private:
+    //==========================================================================
+    static constexpr int numRetiredSlots = 8;
+
+    std::atomic<DspConfig*> pending{ nullptr };
+    DspConfig* live = nullptr;                       // thread audio uniquement
+    std::atomic<DspConfig*> retired[numRetiredSlots]{};
+
+    JUCE_DECLARE_NON_COPYABLE(DspConfigExchange)
+};
@@ -0,0 +1,274 @@
+﻿/*
+  ==============================================================================
+    FdnReverb.cpp
+    SimpleDelayReverbFDN – reverb FDN
+  ==============================================================================
+*/
+
+#include "FdnReverb.h"
+
+//==============================================================================
+// Helpers
+//==============================================================================
+
+static bool isPrime(int n) noexcept
+{
+    if (n < 2)
+        return false;
+
+    for (int d = 2; d * d <= n; ++d)
+        if (n % d == 0)
+            return false;
+
+    return true;
+}
+
+// Transformée de Hadamard rapide, normalisée (matrice orthogonale)
+static void hadamard(float* x, int n) noexcept
+{
+    for (int h = 1; h < n; h <<= 1)
+    {
+        for (int i = 0; i < n; i += h * 2)
+        {
+            for (int j = i; j < i + h; ++j)
+            {
+                const float a = x[j];
+                const float b = x[j + h];
+                x[j] = a + b;
+                x[j + h] = a - b;
+            }
+        }
+    }
+
+    const float norm = 1.0f / std::sqrt((float)n);
+    for (int i = 0; i < n; ++i)
+        x[i] *= norm;
+}
+
+//==============================================================================
+// Nombre de lignes
+//==============================================================================
+
+const juce::StringArray& FdnReverb::getLineCountNames()
+{
+    static const juce::StringArray names{ "8", "16", "32", "64" };
+    return names;
+}
+
+int FdnReverb::lineCountFromIndex(int index) noexcept
+{
+    return 8 << juce::jlimit(0, 3, index);
+}
+
+//==============================================================================
+// Préparation
+//==============================================================================
+
+// Longueurs espacées géométriquement entre 29 et 73 ms, arrondies au
+// nombre premier suivant pour éviter les résonances communes
+static void computeLineLengths(int* lengths, int count, double sampleRate) noexcept
+{
+    const double minMs = 29.0, maxMs = 73.0;
+
+    for (int n = 0; n < count; ++n)
+    {
+        const double ms = minMs * std::pow(maxMs / minMs, n / (double)(count - 1));
+        int len = (int)(sampleRate * ms / 1000.0);
+
+        while (!isPrime(len))
+            ++len;
+
+        lengths[n] = len;
+    }
+}
+
+void FdnReverb::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    // Place pour la plus longue ligne, quel que soit le nombre de lignes choisi
+    int lengths[maxLines];
+    computeLineLengths(lengths, maxLines, sampleRate);
+
+    jassert(lengths[0] >= subBlockSize);
+    lines.setSize(maxLines, lengths[maxLines - 1]);
+
+    decay.prepare(sampleRate);
+
+    numLines = juce::jlimit(8, maxLines, parameters.numLines);
+    updateLineLengths();
+    reset();
+    updateDecay();
+}
+
+void FdnReverb::reset()
+{
+    lines.clear();
+    decay.reset();
+
+    std::fill(std::begin(frame), std::end(frame), 0.0f);
+    pendingLength = 0;
+
+    for (auto& p : linePos)
+        p = 0;
+}
+
+void FdnReverb::updateLineLengths() noexcept
+{
+    computeLineLengths(lineLength, numLines, sampleRate);
+}
+
+//==============================================================================
+// Paramètres
+//==============================================================================
+
+float FdnReverb::roomSizeToSeconds(float roomSize) noexcept
+{
+    // 0.1 -> ~0.4 s, 1.0 -> 8 s
+    return 0.3f + 7.7f * roomSize * roomSize;
+}
+
+void FdnReverb::setParameters(const Parameters& newParams)
+{
+    const bool sizeChanged = newParams.numLines != parameters.numLines;
+    const bool decayChanged = sizeChanged
+                           || newParams.roomSize != parameters.roomSize
+                           || newParams.lowDecay != parameters.lowDecay
+                           || newParams.highDecay != parameters.highDecay;
+
+    parameters = newParams;
+
+    if (sizeChanged && lines.getNumSamples() > 0)
+    {
+        numLines = juce::jlimit(8, maxLines, parameters.numLines);
+        updateLineLengths();
+        reset();
+    }
+
+    if (decayChanged)
+        updateDecay();
+}
+
+void FdnReverb::updateDecay() noexcept
+{
+    // g = 10^(-3 * L / (T60 * fs)) : -60 dB après T60 secondes
+    const float t60 = roomSizeToSeconds(parameters.roomSize);
+    float gains[maxLines];
+
+    for (int n = 0; n < numLines; ++n)
+        gains[n] = std::pow(10.0f, -3.0f * (float)lineLength[n] / (t60 * (float)sampleRate));
+
+    decay.setGains(gains, numLines, parameters.lowDecay, parameters.highDecay * naturalHighDecay);
+}
+
+//==============================================================================
+// Traitement
+//==============================================================================
+
+void FdnReverb::processGroupCallback(void* context, int group) noexcept
+{
+    static_cast<FdnReverb*>(context)->processGroup(group);
+}
+
+void FdnReverb::processGroup(int group) noexcept
+{
+    const int first = group * linesPerGroup;
+    const int count = juce::jmin(linesPerGroup, numLines - first);
+
+    for (int n = first; n < first + count; ++n)
+    {
+        float* line = lines.getWritePointer(n);
+        const int len = lineLength[n];
+        int pos = linePos[n];
+
+        // Ecriture du sous-bloc précédent (après mélange), puis lecture du
+        // suivant aux positions qui suivent
+        for (int i = 0; i < pendingLength; ++i)
+        {
+            line[pos] = frame[i * maxLines + n];
+
+            if (++pos >= len)
+                pos = 0;
+        }
+
+        linePos[n] = pos;
+
+        for (int i = 0; i < currentLength; ++i)
+        {
+            frame[i * maxLines + n] = line[pos];
+
+            if (++pos >= len)
+                pos = 0;
+        }
+    }
+
+    // Décroissance dépendante de la fréquence, toutes les lignes du groupe à la fois
+    for (int i = 0; i < currentLength; ++i)
+        decay.processSample(frame + i * maxLines, first, count);
+}
+
+void FdnReverb::processSubBlock(float* left, float* right, int numSamples) noexcept
+{
+    currentLength = numSamples;
+
+    // Etape parallèle : un groupe de lignes par worker (ou tout ici sans worker)
+    const int numGroups = (numLines + linesPerGroup - 1) / linesPerGroup;
+    workerPool.run(&FdnReverb::processGroupCallback, this, numGroups);
+
+    // Etape de synchro : sorties, mélange orthogonal, entrée
+    const float outGain = 1.0f / std::sqrt((float)numLines);
+    const auto mix = StereoMix::make(parameters.dryLevel, parameters.wetLevel * outGain,
+                                     parameters.width, parameters.balance);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float* x = frame + i * maxLines;
+
+        // Sorties : lignes paires -> gauche, impaires -> droite (signes alternés)
+        float outL = 0.0f, outR = 0.0f;
+
+        for (int n = 0; n < numLines; n += 2)
+        {
+            const float sign = (n & 2) ? -1.0f : 1.0f;
+            outL += sign * x[n];
+            outR += sign * x[n + 1];
+        }
+
+        hadamard(x, numLines);
+
+        const float inL = left[i];
+        const float inR = right != nullptr ? right[i] : inL;
+
+        for (int n = 0; n < numLines; ++n)
+        {
+            const float in = 0.5f * ((n & 1) ? inR : inL);
+            x[n] += (n & 4) ? -in : in;
+        }
+
+        // Mix dry / wet, largeur et balance
+        if (right != nullptr)
+            mix.apply(inL, inR, outL, outR, left[i], right[i]);
+        else
+            left[i] = mix.applyMono(inL, outL, outR);
+    }
+
+    pendingLength = numSamples;
+}
+
+void FdnReverb::processStereo(float* left, float* right, int numSamples) noexcept
+{
+    for (int done = 0; done < numSamples; done += subBlockSize)
+    {
+        const int num = juce::jmin(subBlockSize, numSamples - done);
+        processSubBlock(left + done, right + done, num);
+    }
+}
+
+void FdnReverb::processMono(float* samples, int numSamples) noexcept
+{
+    for (int done = 0; done < numSamples; done += subBlockSize)
+    {
+        const int num = juce::jmin(subBlockSize, numSamples - done);
+        processSubBlock(samples + done, nullptr, num);
+    }
+}
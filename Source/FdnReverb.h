@@ -0,0 +1,101 @@
+﻿/*
+  ==============================================================================
+    FdnReverb.h
+    SimpleDelayReverbFDN – reverb à réseau de lignes à retard (FDN)
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DecayFilterBank.h"
+#include "FdnWorkerPool.h"
+#include "StereoMix.h"
+
+//==============================================================================
+// FDN 8 à 64 lignes, matrice de Hadamard, filtres de décroissance 3 bandes
+// dans la boucle de feedback. Même usage que juce::Reverb (setParameters /
+// processStereo / processMono), pour rester interchangeable côté processeur.
+//
+// Traitement par sous-blocs de subBlockSize échantillons (toutes les lignes
+// sont plus longues) : chaque groupe de linesPerGroup lignes lit et filtre
+// son sous-bloc indépendamment, éventuellement sur un worker, puis la
+// matrice de mélange est appliquée dans une étape de synchro sur le thread
+// appelant. Le résultat est identique à un traitement échantillon par
+// échantillon.
+//==============================================================================
+class FdnReverb
+{
+public:
+    static constexpr int maxLines = 64;
+    static constexpr int linesPerGroup = 16;
+    static constexpr int subBlockSize = 64;
+
+    // Amortissement aigu propre à la reverb, comme le damping 0.5 fixe de
+    // juce::Reverb qu'elle remplace : highDecay le multiplie (x1 = ce son-là)
+    static constexpr float naturalHighDecay = 0.5f;
+
+    // Choix "Reverb Lines" : 8 / 16 / 32 / 64
+    static const juce::StringArray& getLineCountNames();
+    static int lineCountFromIndex(int index) noexcept;
+
+    struct Parameters
+    {
+        int   numLines = 8;      // puissance de 2, 8..maxLines
+        float roomSize = 0.5f;   // 0..1 -> temps de décroissance médium
+        float lowDecay = 1.0f;   // multiplicateur T60 grave
+        float highDecay = 1.0f;  // multiplicateur T60 aigu (x naturalHighDecay)
+        float wetLevel = 0.33f;
+        float dryLevel = 0.4f;
+        float width = 1.0f;      // largeur du wet (0 = mono .. 2)
+        float balance = 0.0f;    // -1 (gauche) .. +1 (droite)
+    };
+
+    //==========================================================================
+    // Alloue les lignes : à appeler hors thread audio
+    void prepare(double sampleRate);
+    void reset();
+
+    // Workers pour les groupes de lignes (0 = mono-thread). Hors thread audio.
+    void startWorkers(int numWorkers) { workerPool.start(numWorkers); }
+    void stopWorkers() { workerPool.stop(); }
+    int getNumWorkers() const noexcept { return workerPool.getNumWorkers(); }
+
+    // Les gains de boucle ne sont recalculés que si un paramètre de décroissance
+    // change ; un changement du nombre de lignes repart d'une queue vide
+    void setParameters(const Parameters& newParams);
+    const Parameters& getParameters() const noexcept { return parameters; }
+
+    void processStereo(float* left, float* right, int numSamples) noexcept;
+    void processMono(float* samples, int numSamples) noexcept;
+
+    // Temps de décroissance médium (s) associé à une taille de pièce
+    static float roomSizeToSeconds(float roomSize) noexcept;
+
+private:
+    //==========================================================================
+    void updateLineLengths() noexcept;
+    void updateDecay() noexcept;
+
+    void processSubBlock(float* left, float* right, int numSamples) noexcept;
+    void processGroup(int group) noexcept;
+    static void processGroupCallback(void* context, int group) noexcept;
+
+    double sampleRate = 44100.0;
+    Parameters parameters;
+    int numLines = 8;
+
+    juce::AudioBuffer<float> lines;          // une ligne par canal du buffer
+    int lineLength[maxLines] = {};
+    int linePos[maxLines] = {};
+
+    // Trame du sous-bloc, rangée échantillon par échantillon : frame[i * maxLines + n].
+    // Après la synchro elle contient ce qu'il reste à écrire dans les lignes,
+    // écrit par chaque groupe au début du sous-bloc suivant.
+    alignas(64) float frame[subBlockSize * maxLines] = {};
+    int pendingLength = 0;      // échantillons de la trame à écrire
+    int currentLength = 0;      // taille du sous-bloc en cours
+
+    DecayFilterBank<maxLines> decay;
+    FdnWorkerPool workerPool;
+};
@@ -0,0 +1,236 @@
+﻿/*
+  ==============================================================================
+    FdnWorkerPool.cpp
+    SimpleDelayReverbFDN – threads de calcul temps réel pour la FDN
+  ==============================================================================
+*/
+
+#include "FdnWorkerPool.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+ #include <ctime>
+#endif
+
+//==============================================================================
+// Sémaphore de réveil
+//==============================================================================
+
+#if JUCE_WINDOWS
+
+FdnWorkerPool::WakeSemaphore::WakeSemaphore() : handle(CreateSemaphore(nullptr, 0, 0x7fffffff, nullptr)) {}
+FdnWorkerPool::WakeSemaphore::~WakeSemaphore() { CloseHandle((HANDLE)handle); }
+void FdnWorkerPool::WakeSemaphore::signal() noexcept { ReleaseSemaphore((HANDLE)handle, 1, nullptr); }
+void FdnWorkerPool::WakeSemaphore::wait(int timeoutMs) noexcept { WaitForSingleObject((HANDLE)handle, (DWORD)timeoutMs); }
+
+#elif JUCE_MAC || JUCE_IOS
+
+FdnWorkerPool::WakeSemaphore::WakeSemaphore() : handle(dispatch_semaphore_create(0)) {}
+FdnWorkerPool::WakeSemaphore::~WakeSemaphore() { dispatch_release((dispatch_semaphore_t)handle); }
+void FdnWorkerPool::WakeSemaphore::signal() noexcept { dispatch_semaphore_signal((dispatch_semaphore_t)handle); }
+
+void FdnWorkerPool::WakeSemaphore::wait(int timeoutMs) noexcept
+{
+    dispatch_semaphore_wait((dispatch_semaphore_t)handle,
+        dispatch_time(DISPATCH_TIME_NOW, (int64_t)timeoutMs * (int64_t)NSEC_PER_MSEC));
+}
+
+#else
+
+// sem_post n'est qu'un atomique + futex : ni mutex pthread, ni allocation
+FdnWorkerPool::WakeSemaphore::WakeSemaphore()
+{
+    auto* s = new sem_t;
+    sem_init(s, 0, 0);
+    handle = s;
+}
+
+FdnWorkerPool::WakeSemaphore::~WakeSemaphore()
+{
+    auto* s = static_cast<sem_t*>(handle);
+    sem_destroy(s);
+    delete s;
+}
+
+void FdnWorkerPool::WakeSemaphore::signal() noexcept { sem_post(static_cast<sem_t*>(handle)); }
+
+void FdnWorkerPool::WakeSemaphore::wait(int timeoutMs) noexcept
+{
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += (long)timeoutMs * 1000000L;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+    deadline.tv_nsec %= 1000000000L;
+
+    while (sem_timedwait(static_cast<sem_t*>(handle), &deadline) != 0 && errno == EINTR)
+    {
+    }
+}
+
+#endif
+
+//==============================================================================
+// Lancement / arrêt
+//==============================================================================
+
+FdnWorkerPool::~FdnWorkerPool()
+{
+    stop();
+}
+
+void FdnWorkerPool::start(int numWorkers)
+{
+    if (numWorkers == workers.size())
+        return;
+
+    stop();
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto w = std::make_unique<Worker>(*this);
+
+        // Temps réel ou rien : le thread audio attend la fin des groupes pris
+        // par les workers, un worker non temps réel préempté au milieu d'un
+        // groupe le bloquerait sans borne. Sans temps réel, le traitement
+        // reste sur le thread audio (workers déjà lancés gardés).
+        if (!w->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(10)))
+            break;
+
+        workers.add(w.release());
+    }
+
+    numRunning.store(workers.size(), std::memory_order_release);
+}
+
+void FdnWorkerPool::stop()
+{
+    // Un worker ne sort qu'entre deux groupes : un groupe pris est toujours terminé
+    numRunning.store(0, std::memory_order_release);
+
+    for (auto* w : workers)
+        w->signalThreadShouldExit();
+
+    for (int i = 0; i < workers.size(); ++i)
+        wake.signal();
+
+    for (auto* w : workers)
+        w->stopThread(1000);
+
+    workers.clear();
+}
+
+//==============================================================================
+// Distribution du travail
+//==============================================================================
+
+void FdnWorkerPool::run(Job job, void* context, int numGroups) noexcept
+{
+    jassert(numGroups < 0x10000);
+
+    if (getNumWorkers() == 0 || numGroups <= 1)
+    {
+        for (int g = 0; g < numGroups; ++g)
+            job(context, g);
+
+        return;
+    }
+
+    // Les champs sont publiés par le store "release" de state ; ils ne
+    // changent plus tant que tous les groupes ne sont pas terminés
+    currentJob = job;
+    currentContext = context;
+    groupsDone.store(0, std::memory_order_relaxed);
+
+    ++generation;
+    state.store(((juce::uint64)generation << 32) | ((juce::uint64)numGroups << 16),
+        std::memory_order_release);
+
+    // Réveil des workers endormis (au plus un par groupe restant). La
+    // barrière, symétrique de celle du worker, garantit que soit le worker
+    // voit le travail avant de dormir, soit on le voit endormi ici.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const int toWake = juce::jmin(numSleeping.load(std::memory_order_relaxed), numGroups - 1);
+
+    for (int i = 0; i < toWake; ++i)
+        wake.signal();
+
+    // Le thread audio travaille aussi
+    while (runOneGroup())
+    {
+    }
+
+    // Attente des groupes encore en cours chez les workers (durée d'un groupe au plus)
+    while (groupsDone.load(std::memory_order_acquire) < numGroups)
+        std::this_thread::yield();
+}
+
+bool FdnWorkerPool::runOneGroup() noexcept
+{
+    auto s = state.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        const int total = (int)((s >> 16) & 0xffff);
+        const int next = (int)(s & 0xffff);
+
+        if (next >= total)
+            return false;
+
+        if (state.compare_exchange_weak(s, s + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            // Un groupe est du travail audio, quel que soit le thread qui l'exécute
+            SIMPLEREVERB_AUDIT_SCOPE
+            currentJob(currentContext, next);
+            groupsDone.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+//==============================================================================
+// Boucle des workers
+//==============================================================================
+
+void FdnWorkerPool::Worker::run()
+{
+    // ~ quelques centaines de µs de boucle active après un travail, puis
+    // sommeil sur le sémaphore, réveillé par run(). Le délai ne sert qu'à
+    // revoir threadShouldExit() (stop() signale aussi le sémaphore).
+    constexpr int spinIterations = 4000;
+    constexpr int sleepTimeoutMs = 100;
+
+    int idleSpins = 0;
+
+    while (!threadShouldExit())
+    {
+        if (pool.runOneGroup())
+        {
+            idleSpins = 0;
+            continue;
+        }
+
+        if (idleSpins < spinIterations)
+        {
+            ++idleSpins;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Annonce du sommeil, puis dernière vérification (cf. run())
+        pool.numSleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (pool.runOneGroup())
+            idleSpins = 0;
+        else
+            pool.wake.wait(sleepTimeoutMs);
+
+        pool.numSleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,96 @@
+﻿/*
+  ==============================================================================
+    FdnWorkerPool.h
+    SimpleDelayReverbFDN – threads de calcul temps réel pour la FDN
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AudioThreadAudit.h"
+
+//==============================================================================
+// Petit pool de workers pré-lancés. Le thread audio publie un travail
+// découpé en groupes ; workers ET thread audio se partagent les groupes via
+// un compteur atomique, puis le thread audio attend (en bouclant) la fin des
+// groupes pris par les workers.
+//
+// - aucun lock ni allocation côté thread audio
+// - un worker endormi ne bloque rien : le thread audio prend les groupes
+//   restants lui-même (sans worker, tout est simplement mono-thread)
+// - workers temps réel uniquement : si l'OS refuse, pas de worker
+// - les workers bouclent brièvement entre deux travaux, puis s'endorment sur
+//   un sémaphore que run() signale : la reprise ne dépend pas d'un pas de
+//   sommeil, le thread audio n'attend pas un worker en train de dormir
+//==============================================================================
+class FdnWorkerPool
+{
+public:
+    using Job = void (*)(void* context, int group);
+
+    FdnWorkerPool() = default;
+    ~FdnWorkerPool();
+
+    //==========================================================================
+    // Hors thread audio. Démarre au plus numWorkers threads temps réel ;
+    // getNumWorkers() donne le nombre réellement lancé.
+    void start(int numWorkers);
+    void stop();
+    int getNumWorkers() const noexcept { return numRunning.load(std::memory_order_acquire); }
+
+    //==========================================================================
+    // Thread audio : exécute job(context, 0 .. numGroups-1) et rend la main
+    // quand tous les groupes sont terminés
+    void run(Job job, void* context, int numGroups) noexcept;
+
+private:
+    //==========================================================================
+    // Sémaphore de réveil. signal() ne prend aucun verrou (futex, dispatch,
+    // objet noyau Windows) : appelable depuis le thread audio
+    class WakeSemaphore
+    {
+    public:
+        WakeSemaphore();
+        ~WakeSemaphore();
+
+        void signal() noexcept;
+        void wait(int timeoutMs) noexcept;
+
+    private:
+        void* handle = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE(WakeSemaphore)
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        explicit Worker(FdnWorkerPool& p) : juce::Thread("FDN worker"), pool(p) {}
+        void run() override;
+
+    private:
+        FdnWorkerPool& pool;
+    };
+
+    // Prend un groupe du travail en cours et l'exécute ; false s'il n'y en a plus
+    bool runOneGroup() noexcept;
+
+    // Etat packé : génération (32 bits) | nombre de groupes (16) | prochain groupe (16).
+    // Une prise ne réussit que sur la génération observée : un worker en retard
+    // ne peut pas prendre un groupe du travail suivant.
+    std::atomic<juce::uint64> state{ 0 };
+    std::atomic<int> groupsDone{ 0 };
+    juce::uint32 generation = 0;           // thread audio uniquement
+
+    Job currentJob = nullptr;
+    void* currentContext = nullptr;
+
+    juce::OwnedArray<Worker> workers;     // thread message uniquement
+    std::atomic<int> numRunning{ 0 };      // lu par le thread audio
+
+    WakeSemaphore wake;
+    std::atomic<int> numSleeping{ 0 };     // workers bloqués (ou sur le point de l'être) sur wake
+
+    JUCE_DECLARE_NON_COPYABLE(FdnWorkerPool)
+};
@@ -0,0 +1,254 @@
+﻿/*
+  ==============================================================================
+    FeedbackSaturator.h
+    SimpleDelayReverbFDN – saturation douce suréchantillonnée (boucle de feedback)
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Saturation placée dans la boucle de feedback, suréchantillonnée 2x ou 4x
+// uniquement sur ce chemin (un échantillon par voie à la fois).
+//
+// Sur/sous-échantillonnage par filtres demi-bande polyphases IIR : deux
+// branches de cellules passe-tout du 1er ordre, calculées à la fréquence
+// basse. Coefficients elliptiques :
+//   - étage 1x <-> 2x : 8 coefficients, transition 0.04, ~ -99 dB
+//   - étage 2x <-> 4x : 4 coefficients, transition 0.2,  ~ -100 dB
+//     (à 4x le signal utile n'occupe que le bas de la bande)
+//
+// La courbe est bornée (|y| <= 1) : un feedback > 1 reste stable, la boucle
+// s'auto-entretient au niveau de saturation au lieu de diverger.
+//
+// Un changement de facteur ne remet rien à zéro en pleine boucle : l'ancien
+// et le nouveau chemin tournent ensemble le temps d'un fondu de fadeLength
+// échantillons (chaque facteur a ses propres filtres).
+//
+// Comme DecayFilterBank, états rangés voie par voie (SoA) : les boucles
+// internes portent sur les voies.
+//==============================================================================
+template <int MaxLanes>
+class FeedbackSaturator
+{
+public:
+    static constexpr int maxLanes = MaxLanes;
+    static constexpr int fadeLength = 256;
+
+    // Choix "Saturation" : Off / 2x / 4x
+    static const juce::StringArray& getOversamplingNames()
+    {
+        static const juce::StringArray names{ "Off", "2x", "4x" };
+        return names;
+    }
+
+    //==========================================================================
+    void reset() noexcept
+    {
+        resetPath(1);
+        resetPath(2);
+        fadeRemaining = 0;
+    }
+
+    // 0 = désactivée, 1 = 2x, 2 = 4x. Fondu de l'ancien vers le nouveau chemin,
+    // dont les filtres partent de zéro.
+    void setOversampling(int newIndex) noexcept
+    {
+        newIndex = juce::jlimit(0, 2, newIndex);
+
+        if (newIndex != oversampling)
+        {
+            previous = oversampling;
+            oversampling = newIndex;
+            resetPath(oversampling);
+            fadeRemaining = fadeLength;
+        }
+    }
+
+    int getOversampling() const noexcept { return oversampling; }
+
+    //==========================================================================
+    // Sature un échantillon par voie, sur place (x[0 .. numLanes-1])
+    void processSample(float* x, int numLanes) noexcept
+    {
+        jassert(numLanes <= MaxLanes);
+
+        if (fadeRemaining == 0)
+        {
+            processPath(oversampling, x, numLanes);
+            return;
+        }
+
+        alignas(16) float old[MaxLanes] = {};
+        std::copy(x, x + numLanes, old);
+
+        processPath(previous, old, numLanes);
+        processPath(oversampling, x, numLanes);
+
+        const float oldWeight = (float)fadeRemaining / (float)fadeLength;
+
+        for (int n = 0; n < numLanes; ++n)
+            x[n] += oldWeight * (old[n] - x[n]);
+
+        --fadeRemaining;
+    }
+
+private:
+    //==========================================================================
+    void resetPath(int index) noexcept
+    {
+        if (index == 1)
+        {
+            outer2.reset();
+        }
+        else if (index == 2)
+        {
+            outer4.reset();
+            inner4.reset();
+        }
+    }
+
+    void processPath(int index, float* x, int numLanes) noexcept
+    {
+        if (index == 0)
+            return;
+
+        alignas(16) float a[MaxLanes] = {}, b[MaxLanes] = {};
+
+        if (index == 1)
+        {
+            outer2.upsample(x, a, b, numLanes);
+            saturate(a, numLanes);
+            saturate(b, numLanes);
+            outer2.downsample(a, b, x, numLanes);
+            return;
+        }
+
+        // Les deux échantillons 2x passent l'un après l'autre dans l'étage 4x
+        alignas(16) float a0[MaxLanes] = {}, a1[MaxLanes] = {}, b0[MaxLanes] = {}, b1[MaxLanes] = {};
+        outer4.upsample(x, a, b, numLanes);
+        inner4.upsample(a, a0, a1, numLanes);
+        inner4.upsample(b, b0, b1, numLanes);
+
+        saturate(a0, numLanes);
+        saturate(a1, numLanes);
+        saturate(b0, numLanes);
+        saturate(b1, numLanes);
+
+        inner4.downsample(a0, a1, a, numLanes);
+        inner4.downsample(b0, b1, b, numLanes);
+        outer4.downsample(a, b, x, numLanes);
+    }
+
+    //==========================================================================
+    // Approximation rationnelle de tanh, exacte en 0 et bornée à +-1 (|x| >= 3)
+    static void saturate(float* x, int numLanes) noexcept
+    {
+        for (int n = 0; n < numLanes; ++n)
+        {
+            const float v = juce::jlimit(-3.0f, 3.0f, x[n]);
+            const float v2 = v * v;
+            x[n] = v * (27.0f + v2) / (27.0f + 9.0f * v2);
+        }
+    }
+
+    //==========================================================================
+    // Cascade de passe-tout A(z) = (a + z^-1) / (1 + a z^-1), une par coefficient.
+    // mem[k] : entrée précédente de la cellule k (= sortie précédente de k-1)
+    template <int NumSections>
+    struct AllpassChain
+    {
+        float coef[NumSections] = {};
+        alignas(16) float mem[NumSections + 1][MaxLanes] = {};
+
+        void reset() noexcept
+        {
+            for (auto& m : mem)
+                std::fill(std::begin(m), std::end(m), 0.0f);
+        }
+
+        void process(float* x, int numLanes) noexcept
+        {
+            for (int k = 0; k < NumSections; ++k)
+            {
+                const float c = coef[k];
+
+                for (int n = 0; n < numLanes; ++n)
+                {
+                    const float in = x[n];
+                    x[n] = c * (in - mem[k + 1][n]) + mem[k][n];
+                    mem[k][n] = in;
+                }
+            }
+
+            std::copy(x, x + numLanes, mem[NumSections]);
+        }
+    };
+
+    //==========================================================================
+    // Filtre demi-bande H(z) = 1/2 [A0(z^2) + z^-1 A1(z^2)] :
+    // A0 reçoit les coefficients pairs, A1 les impairs
+    template <int NumCoefs>
+    struct HalfBand
+    {
+        static constexpr int numPerPath = NumCoefs / 2;
+
+        AllpassChain<numPerPath> up0, up1, down0, down1;
+
+        explicit HalfBand(const float (&coefs)[NumCoefs]) noexcept
+        {
+            for (int k = 0; k < numPerPath; ++k)
+            {
+                up0.coef[k] = down0.coef[k] = coefs[2 * k];
+                up1.coef[k] = down1.coef[k] = coefs[2 * k + 1];
+            }
+        }
+
+        void reset() noexcept
+        {
+            up0.reset();
+            up1.reset();
+            down0.reset();
+            down1.reset();
+        }
+
+        // 1 échantillon -> 2 (out0 puis out1)
+        void upsample(const float* in, float* out0, float* out1, int numLanes) noexcept
+        {
+            std::copy(in, in + numLanes, out0);
+            std::copy(in, in + numLanes, out1);
+            up0.process(out0, numLanes);
+            up1.process(out1, numLanes);
+        }
+
+        // 2 échantillons (in0 puis in1) -> 1. Les entrées servent de tampon.
+        void downsample(float* in0, float* in1, float* out, int numLanes) noexcept
+        {
+            down1.process(in0, numLanes);
+            down0.process(in1, numLanes);
+
+            for (int n = 0; n < numLanes; ++n)
+                out[n] = 0.5f * (in0[n] + in1[n]);
+        }
+    };
+
+    static constexpr float outerCoefs[8] =
+    {
+        0.040633462f, 0.150505126f, 0.300757051f, 0.460774511f,
+        0.609524310f, 0.738503814f, 0.849223793f, 0.949742794f
+    };
+
+    static constexpr float innerCoefs[4] =
+    {
+        0.049551036f, 0.193570331f, 0.426736683f, 0.767070055f
+    };
+
+    HalfBand<8> outer2{ outerCoefs };      // chemin 2x
+    HalfBand<8> outer4{ outerCoefs };      // chemin 4x
+    HalfBand<4> inner4{ innerCoefs };
+
+    int oversampling = 0, previous = 0;
+    int fadeRemaining = 0;
+};
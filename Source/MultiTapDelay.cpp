@@ -0,0 +1,285 @@
+﻿/*
+  ==============================================================================
+    MultiTapDelay.cpp
+    SimpleDelayReverbFDN – delay multi-taps
+  ==============================================================================
+*/
+
+#include "MultiTapDelay.h"
+
+//==============================================================================
+// Divisions / valeurs par défaut
+//==============================================================================
+
+static constexpr double divisionBeats[] =
+{
+    0.125,            // 1/32
+    1.0 / 6.0,        // 1/16T
+    0.25,             // 1/16
+    1.0 / 3.0,        // 1/8T
+    0.375,            // 1/16D
+    0.5,              // 1/8
+    2.0 / 3.0,        // 1/4T
+    0.75,             // 1/8D
+    1.0,              // 1/4
+    4.0 / 3.0,        // 1/2T
+    1.5,              // 1/4D
+    2.0,              // 1/2
+    3.0,              // 1/2D
+    4.0               // 1/1
+};
+
+const juce::StringArray& MultiTapDelay::getDivisionNames()
+{
+    static const juce::StringArray names{ "1/32", "1/16T", "1/16", "1/8T", "1/16D", "1/8", "1/4T",
+                                          "1/8D", "1/4", "1/2T", "1/4D", "1/2", "1/2D", "1/1" };
+    return names;
+}
+
+double MultiTapDelay::getDivisionBeats(int index) noexcept
+{
+    constexpr int numDivisions = (int)(sizeof(divisionBeats) / sizeof(divisionBeats[0]));
+    return divisionBeats[juce::jlimit(0, numDivisions - 1, index)];
+}
+
+MultiTapDelay::Tap MultiTapDelay::getDefaultTap(int index) noexcept
+{
+    // 1/8, 1/4, 1/4D, 1/2 en ping-pong, seul le dernier réinjecte
+    static constexpr Tap pattern[] =
+    {
+        { 5,  0.80f, -0.6f, 0.0f },
+        { 8,  0.65f,  0.6f, 0.0f },
+        { 10, 0.50f, -0.3f, 0.0f },
+        { 11, 0.35f,  0.3f, 1.0f }
+    };
+
+    if (juce::isPositiveAndBelow(index, 4))
+        return pattern[index];
+
+    return {};
+}
+
+juce::String MultiTapDelay::paramId(int index, const char* suffix)
+{
+    return juce::String("tap") + juce::String(index + 1) + suffix;
+}
+
+//==============================================================================
+// Préparation
+//==============================================================================
+
+void MultiTapDelay::prepare(double newSampleRate, int maxBlockSize)
+{
+    sampleRate = newSampleRate;
+    scratchSize = juce::jmax(1, maxBlockSize);
+
+    // Taille en puissance de 2 : le retard maximal + une tranche de travail,
+    // pour qu'une lecture ne rattrape jamais l'écriture de la même tranche
+    ringSize = juce::nextPowerOfTwo((int)(sampleRate * maxDelaySeconds) + scratchSize);
+    ringMask = ringSize - 1;
+    ring.allocate((size_t)ringSize, true);
+
+    scratch.setSize(4, scratchSize);
+    decay.prepare(sampleRate);
+
+    reset();
+    updateTaps();
+    updateDecay();
+}
+
+void MultiTapDelay::reset()
+{
+    if (ringSize > 0)
+        ring.clear((size_t)ringSize);
+
+    writePos = 0;
+    decay.reset();
+    saturator.reset();
+}
+
+//==============================================================================
+// Paramètres
+//==============================================================================
+
+void MultiTapDelay::setParameters(const Parameters& newParams) noexcept
+{
+    bool tapsChanged = newParams.numTaps != parameters.numTaps || newParams.bpm != parameters.bpm;
+
+    for (int t = 0; t < maxTaps && !tapsChanged; ++t)
+    {
+        const auto& a = newParams.taps[t];
+        const auto& b = parameters.taps[t];
+        tapsChanged = a.division != b.division || a.gain != b.gain
+                   || a.pan != b.pan || a.feedback != b.feedback;
+    }
+
+    const bool decayChanged = newParams.feedback != parameters.feedback
+                           || newParams.overdrive != parameters.overdrive
+                           || newParams.saturation != parameters.saturation
+                           || newParams.lowDecay != parameters.lowDecay
+                           || newParams.highDecay != parameters.highDecay;
+
+    parameters = newParams;
+    saturator.setOversampling(parameters.saturation);
+
+    if (tapsChanged)
+        updateTaps();
+
+    if (decayChanged)
+        updateDecay();
+}
+
+void MultiTapDelay::updateTaps() noexcept
+{
+    if (ringSize == 0)
+        return;
+
+    const double samplesPerBeat = sampleRate * 60.0 / juce::jmax(1.0, parameters.bpm);
+    const int maxOffset = ringSize - scratchSize;
+
+    numActive = juce::jlimit(0, maxTaps, parameters.numTaps);
+    minOffset = maxOffset;
+
+    // Les envois sont sommés dans la boucle : normalisés pour que le gain de
+    // boucle linéaire reste <= feedback, quel que soit le nombre de taps
+    float sendSum = 0.0f;
+
+    for (int t = 0; t < numActive; ++t)
+        sendSum += std::abs(parameters.taps[t].feedback);
+
+    const float sendScale = 1.0f / juce::jmax(1.0f, sendSum);
+
+    for (int t = 0; t < numActive; ++t)
+    {
+        const auto& tap = parameters.taps[t];
+
+        tapOffset[t] = juce::jlimit(1, maxOffset,
+            (int)std::lround(getDivisionBeats(tap.division) * samplesPerBeat));
+        minOffset = juce::jmin(minOffset, tapOffset[t]);
+
+        // Pan à puissance constante
+        const float angle = (juce::jlimit(-1.0f, 1.0f, tap.pan) + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+        tapGainL[t] = tap.gain * std::cos(angle);
+        tapGainR[t] = tap.gain * std::sin(angle);
+        tapSend[t] = tap.feedback * sendScale;
+    }
+}
+
+void MultiTapDelay::updateDecay() noexcept
+{
+    // Étagères calculées sur le feedback linéaire (< 1) ; l'overdrive, actif
+    // seulement avec la saturation, s'y ajoute en gain plat
+    const float gain = parameters.feedback;
+    decay.setGains(&gain, 1, parameters.lowDecay, parameters.highDecay);
+
+    const float overdrive = parameters.saturation > 0 ? parameters.overdrive : 0.0f;
+    drive = gain > 0.0f ? (gain + overdrive) / gain : 1.0f;
+}
+
+//==============================================================================
+// Traitement
+//==============================================================================
+
+void MultiTapDelay::processStereo(float* left, float* right, int numSamples) noexcept
+{
+    process(left, right, numSamples);
+}
+
+void MultiTapDelay::processMono(float* samples, int numSamples) noexcept
+{
+    process(samples, nullptr, numSamples);
+}
+
+void MultiTapDelay::process(float* left, float* right, int numSamples) noexcept
+{
+    using FVO = juce::FloatVectorOperations;
+
+    if (ringSize == 0)
+        return;
+
+    const auto mix = StereoMix::make(parameters.dryLevel, parameters.wetLevel,
+                                     parameters.width, parameters.balance);
+
+    float* mono = scratch.getWritePointer(0);
+    float* accL = scratch.getWritePointer(1);
+    float* accR = scratch.getWritePointer(2);
+    float* accFb = scratch.getWritePointer(3);
+
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        // Tranche <= plus petit retard : tout ce que les taps lisent est déjà écrit
+        const int num = juce::jmin(numSamples - done, scratchSize, minOffset);
+
+        float* l = left + done;
+        float* r = right != nullptr ? right + done : nullptr;
+
+        // Entrée mono du buffer partagé
+        if (r != nullptr)
+        {
+            FVO::copy(mono, l, num);
+            FVO::add(mono, r, num);
+            FVO::multiply(mono, 0.5f, num);
+        }
+        else
+        {
+            FVO::copy(mono, l, num);
+        }
+
+        FVO::clear(accL, num);
+        FVO::clear(accR, num);
+        FVO::clear(accFb, num);
+
+        // Passe de lecture : un segment contigu par tap (2 morceaux si le
+        // buffer reboucle), accumulé vers G / D / feedback
+        for (int t = 0; t < numActive; ++t)
+        {
+            const int start = (writePos - tapOffset[t]) & ringMask;
+            const int first = juce::jmin(num, ringSize - start);
+            const float* src = ring.get() + start;
+
+            FVO::addWithMultiply(accL, src, tapGainL[t], first);
+            FVO::addWithMultiply(accR, src, tapGainR[t], first);
+
+            if (tapSend[t] != 0.0f)
+                FVO::addWithMultiply(accFb, src, tapSend[t], first);
+
+            if (first < num)
+            {
+                FVO::addWithMultiply(accL + first, ring.get(), tapGainL[t], num - first);
+                FVO::addWithMultiply(accR + first, ring.get(), tapGainR[t], num - first);
+
+                if (tapSend[t] != 0.0f)
+                    FVO::addWithMultiply(accFb + first, ring.get(), tapSend[t], num - first);
+            }
+        }
+
+        // Ecriture : entrée + feedback filtré / saturé (récursif)
+        for (int i = 0; i < num; ++i)
+        {
+            float fb = accFb[i];
+            decay.processSample(&fb, 1);
+            fb *= drive;
+            saturator.processSample(&fb, 1);
+
+            ring[(size_t)writePos] = mono[i] + fb;
+            writePos = (writePos + 1) & ringMask;
+        }
+
+        // Mix dry / wet, largeur et balance : une passe sans dépendance
+        // d'un échantillon à l'autre, vectorisable
+        if (r != nullptr)
+        {
+            for (int i = 0; i < num; ++i)
+                mix.apply(l[i], r[i], accL[i], accR[i], l[i], r[i]);
+        }
+        else
+        {
+            for (int i = 0; i < num; ++i)
+                l[i] = mix.applyMono(l[i], accL[i], accR[i]);
+        }
+
+        done += num;
+    }
+}
@@ -0,0 +1,101 @@
+﻿/*
+  ==============================================================================
+    MultiTapDelay.h
+    SimpleDelayReverbFDN – delay multi-taps synchronisé au tempo
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DecayFilterBank.h"
+#include "FeedbackSaturator.h"
+#include "StereoMix.h"
+
+//==============================================================================
+// Jusqu'à 16 taps lisant tous le même buffer circulaire (mono, taille en
+// puissance de 2). Chaque tap : division musicale, gain, pan, envoi feedback.
+//
+// Les positions / gains des taps ne sont recalculés que si le tempo ou un
+// paramètre change. Le traitement se fait par tranches d'au plus "plus petit
+// retard" échantillons : chaque tap lit alors un segment contigu déjà écrit,
+// accumulé en une passe vectorisée (FloatVectorOperations).
+//==============================================================================
+class MultiTapDelay
+{
+public:
+    static constexpr int maxTaps = 16;
+    static constexpr double maxDelaySeconds = 4.0;
+
+    struct Tap
+    {
+        int   division = 8;     // index dans getDivisionNames()
+        float gain = 0.5f;
+        float pan = 0.0f;       // -1 (gauche) .. +1 (droite)
+        float feedback = 0.0f;  // envoi vers la boucle de feedback
+    };
+
+    struct Parameters
+    {
+        int   numTaps = 4;
+        Tap   taps[maxTaps];
+        double bpm = 120.0;
+        float feedback = 0.4f;  // gain global de la boucle
+        float overdrive = 0.0f; // ajouté au feedback si saturation active
+        int   saturation = 0;   // 0 = Off, 1 = 2x, 2 = 4x
+        float lowDecay = 1.0f;
+        float highDecay = 1.0f;
+        float wetLevel = 0.35f;
+        float dryLevel = 0.65f;
+        float width = 1.0f;     // largeur du wet (0 = mono .. 2)
+        float balance = 0.0f;   // -1 (gauche) .. +1 (droite)
+    };
+
+    //==========================================================================
+    // Divisions musicales (en noires), du plus court au plus long
+    static const juce::StringArray& getDivisionNames();
+    static double getDivisionBeats(int index) noexcept;
+
+    // Réglages par défaut d'un tap (motif de départ sur les 4 premiers)
+    static Tap getDefaultTap(int index) noexcept;
+
+    // Identifiant APVTS d'un paramètre de tap, ex. paramId(0, "Gain") -> "tap1Gain"
+    static juce::String paramId(int index, const char* suffix);
+
+    //==========================================================================
+    // Alloue le buffer et les tampons de travail : hors thread audio
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+
+    void setParameters(const Parameters& newParams) noexcept;
+    const Parameters& getParameters() const noexcept { return parameters; }
+
+    void processStereo(float* left, float* right, int numSamples) noexcept;
+    void processMono(float* samples, int numSamples) noexcept;
+
+private:
+    //==========================================================================
+    void updateTaps() noexcept;
+    void updateDecay() noexcept;
+    void process(float* left, float* right, int numSamples) noexcept;
+
+    double sampleRate = 44100.0;
+    Parameters parameters;
+
+    juce::HeapBlock<float> ring;
+    int ringSize = 0, ringMask = 0, writePos = 0;
+
+    juce::AudioBuffer<float> scratch;   // entrée mono, accumulateurs G / D / feedback
+    int scratchSize = 0;
+
+    // Tables recalculées dans updateTaps()
+    int numActive = 0, minOffset = 1;
+    int   tapOffset[maxTaps] = {};
+    float tapGainL[maxTaps] = {}, tapGainR[maxTaps] = {}, tapSend[maxTaps] = {};
+
+    // Gain plat de l'overdrive, appliqué entre les étagères et la saturation
+    float drive = 1.0f;
+
+    DecayFilterBank<1> decay;
+    FeedbackSaturator<1> saturator;
+};
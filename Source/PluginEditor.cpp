@@ -23,7 +23,7 @@ SimpleReverbAudioProcessorEditor::SimpleReverbAudioProcessorEditor(SimpleReverbA
     setLookAndFeel(&lnf);
 
     // Taille de la fentre
-    setSize(560, 300);
+    setSize(1000, 300);
 
     // -----------------------------------------------------------------------
     // Bandeau suprieur : Mode
@@ -38,6 +38,28 @@ SimpleReverbAudioProcessorEditor::SimpleReverbAudioProcessorEditor(SimpleReverbA
     modeBox.addItem("Delay", 1);
     modeBox.addItem("Reverb", 2);
 
+    addAndMakeVisible(lblType);
+    lblType.setJustificationType(juce::Justification::centred);
+    lblType.setInterceptsMouseClicks(false, false);
+
+    addAndMakeVisible(typeBox);
+    typeBox.addItem("Single", 1);
+    typeBox.addItem("Multi-Tap", 2);
+
+    addAndMakeVisible(lblLines);
+    lblLines.setJustificationType(juce::Justification::centred);
+    lblLines.setInterceptsMouseClicks(false, false);
+
+    addAndMakeVisible(linesBox);
+    linesBox.addItemList(FdnReverb::getLineCountNames(), 1);
+
+    addAndMakeVisible(lblSat);
+    lblSat.setJustificationType(juce::Justification::centred);
+    lblSat.setInterceptsMouseClicks(false, false);
+
+    addAndMakeVisible(satBox);
+    satBox.addItemList(FeedbackSaturator<2>::getOversamplingNames(), 1);
+
     // -----------------------------------------------------------------------
     // Zone centrale : knobs
     // -----------------------------------------------------------------------
@@ -45,15 +67,20 @@ SimpleReverbAudioProcessorEditor::SimpleReverbAudioProcessorEditor(SimpleReverbA
 
     styleKnob(delayMs);
     styleKnob(feedback);
+    styleKnob(overdrive);
     styleKnob(wet);
     styleKnob(roomSize);
+    styleKnob(width);
+    styleKnob(balance);
+    styleKnob(lowDecay);
+    styleKnob(highDecay);
 
     // Ajout visuel des sliders
-    for (auto* c : { &delayMs, &feedback, &wet, &roomSize })
+    for (auto* c : { &delayMs, &feedback, &overdrive, &wet, &roomSize, &width, &balance, &lowDecay, &highDecay })
         addAndMakeVisible(*c);
 
     // Labels au-dessus des knobs
-    for (auto* L : { &lblDelay, &lblFb, &lblWet, &lblRoom })
+    for (auto* L : { &lblDelay, &lblFb, &lblDrive, &lblWet, &lblRoom, &lblWidth, &lblBal, &lblLow, &lblHigh })
     {
         L->setJustificationType(juce::Justification::centred);
         L->setInterceptsMouseClicks(false, false);
@@ -64,10 +91,27 @@ SimpleReverbAudioProcessorEditor::SimpleReverbAudioProcessorEditor(SimpleReverbA
     // Attachments APVTS (liaison UI <-> paramtres DSP)
     // -----------------------------------------------------------------------
     modeAtt = std::make_unique<APVTS::ComboBoxAttachment>(processor.apvts, "mode", modeBox);
+    typeAtt = std::make_unique<APVTS::ComboBoxAttachment>(processor.apvts, "delayType", typeBox);
+
+    // Le type (Single / Multi-Tap) ne concerne que le mode Delay
+    modeBox.onChange = [this] { typeBox.setEnabled(modeBox.getSelectedItemIndex() == 0); };
+    modeBox.onChange();
+
+    linesAtt = std::make_unique<APVTS::ComboBoxAttachment>(processor.apvts, "fdnLines", linesBox);
+    satAtt = std::make_unique<APVTS::ComboBoxAttachment>(processor.apvts, "saturation", satBox);
+
+    // DRIVE n'agit qu'avec la saturation
+    satBox.onChange = [this] { overdrive.setEnabled(satBox.getSelectedItemIndex() > 0); };
+    satBox.onChange();
     delayAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "delayTimeMs", delayMs);
     fbAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "feedback", feedback);
+    driveAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "overdrive", overdrive);
     wetAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "wet", wet);
     roomAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "roomSize", roomSize);
+    widthAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "width", width);
+    balAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "balance", balance);
+    lowAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "lowDecay", lowDecay);
+    highAtt = std::make_unique<APVTS::SliderAttachment>(processor.apvts, "highDecay", highDecay);
 
     // === Formattage du texte sous chaque knob ==============================
     // Affichage propre avec units adaptes
@@ -81,6 +125,11 @@ SimpleReverbAudioProcessorEditor::SimpleReverbAudioProcessorEditor(SimpleReverbA
             return juce::String(v, 3) + " s";
         };
 
+    overdrive.textFromValueFunction = [](double v)
+        {
+            return "+" + juce::String(v, 2);
+        };
+
     wet.textFromValueFunction = [](double v)
         {
             return juce::String(v * 100.0, 1) + " %";
@@ -90,6 +139,29 @@ SimpleReverbAudioProcessorEditor::SimpleReverbAudioProcessorEditor(SimpleReverbA
         {
             return juce::String(v * 100.0, 1) + " %";
         };
+
+    width.textFromValueFunction = [](double v)
+        {
+            return juce::String(v * 100.0, 0) + " %";
+        };
+
+    balance.textFromValueFunction = [](double v)
+        {
+            if (std::abs(v) < 0.005)
+                return juce::String("C");
+
+            return juce::String(v < 0.0 ? "L " : "R ") + juce::String(std::abs(v) * 100.0, 0);
+        };
+
+    lowDecay.textFromValueFunction = [](double v)
+        {
+            return "x" + juce::String(v, 2);
+        };
+
+    highDecay.textFromValueFunction = [](double v)
+        {
+            return "x" + juce::String(v, 2);
+        };
     // ======================================================================
 }
 
@@ -160,14 +232,20 @@ void SimpleReverbAudioProcessorEditor::resized()
     auto row = top.reduced(12);
     auto left = row.removeFromLeft(100);
     lblMode.setBounds(left);
-    modeBox.setBounds(row.removeFromLeft(160).reduced(8, 6));
+    modeBox.setBounds(row.removeFromLeft(120).reduced(8, 6));
+    lblType.setBounds(row.removeFromLeft(80));
+    typeBox.setBounds(row.removeFromLeft(120).reduced(8, 6));
+    lblLines.setBounds(row.removeFromLeft(100));
+    linesBox.setBounds(row.removeFromLeft(100).reduced(8, 6));
+    lblSat.setBounds(row.removeFromLeft(100));
+    satBox.setBounds(row.removeFromLeft(100).reduced(8, 6));
 
     // --- Zone des knobs ---
     auto knobs = bounds.removeFromTop(getHeight() - 90);
     panelKnobs.setBounds(knobs);
 
     auto area = knobs.reduced(16);
-    auto colW = area.getWidth() / 4;   // 4 colonnes
+    auto colW = area.getWidth() / 9;   // 9 colonnes
 
     auto place = [](juce::Label& L, juce::Component& C, juce::Rectangle<int> slot)
         {
@@ -178,6 +256,11 @@ void SimpleReverbAudioProcessorEditor::resized()
 
     place(lblDelay, delayMs, area.removeFromLeft(colW));
     place(lblFb, feedback, area.removeFromLeft(colW));
+    place(lblDrive, overdrive, area.removeFromLeft(colW));
     place(lblWet, wet, area.removeFromLeft(colW));
     place(lblRoom, roomSize, area.removeFromLeft(colW));
+    place(lblWidth, width, area.removeFromLeft(colW));
+    place(lblBal, balance, area.removeFromLeft(colW));
+    place(lblLow, lowDecay, area.removeFromLeft(colW));
+    place(lblHigh, highDecay, area.removeFromLeft(colW));
 }
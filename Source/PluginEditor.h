@@ -218,17 +218,31 @@ private:
     juce::ComboBox modeBox;
     juce::Label    lblMode{ {}, "Mode" };
 
-    juce::Slider delayMs, feedback, wet, roomSize;
+    juce::ComboBox typeBox;
+    juce::Label    lblType{ {}, "Type" };
+
+    juce::ComboBox linesBox;
+    juce::Label    lblLines{ {}, "Lines" };
+
+    juce::ComboBox satBox;
+    juce::Label    lblSat{ {}, "Saturation" };
+
+    juce::Slider delayMs, feedback, overdrive, wet, roomSize, width, balance, lowDecay, highDecay;
 
     juce::Label  lblDelay{ {}, "PRE-DELAY" },
         lblFb{ {}, "DECAY" },
+        lblDrive{ {}, "DRIVE" },
         lblWet{ {}, "BLEND" },
-        lblRoom{ {}, "WIDTH" };
+        lblRoom{ {}, "SIZE" },
+        lblWidth{ {}, "WIDTH" },
+        lblBal{ {}, "BALANCE" },
+        lblLow{ {}, "LOW" },
+        lblHigh{ {}, "HIGH" };
 
     GlassPanel panelTop, panelKnobs;
 
-    std::unique_ptr<APVTS::ComboBoxAttachment> modeAtt;
-    std::unique_ptr<APVTS::SliderAttachment>   delayAtt, fbAtt, wetAtt, roomAtt;
+    std::unique_ptr<APVTS::ComboBoxAttachment> modeAtt, typeAtt, linesAtt, satAtt;
+    std::unique_ptr<APVTS::SliderAttachment>   delayAtt, fbAtt, driveAtt, wetAtt, roomAtt, widthAtt, balAtt, lowAtt, highAtt;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimpleReverbAudioProcessorEditor)
 };
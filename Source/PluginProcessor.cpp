@@ -21,6 +21,11 @@ SimpleReverbAudioProcessor::createParameterLayout()
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         "mode", "Mode", juce::StringArray{ "Delay", "Reverb" }, 0));
 
+    // Type de delay, paramtre  part : "mode" garde ses deux choix (et donc
+    // sa valeur normalise) pour les sessions / automations existantes
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "delayType", "Delay Type", juce::StringArray{ "Single", "Multi-Tap" }, 0));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "delayTimeMs", "Delay Time (ms)",
         juce::NormalisableRange<float>(1.0f, 1000.0f, 0.01f, 0.5f), 350.0f));
@@ -29,6 +34,16 @@ SimpleReverbAudioProcessor::createParameterLayout()
         "feedback", "Feedback",
         juce::NormalisableRange<float>(0.0f, 0.95f, 0.0f, 0.5f), 0.4f));
 
+    // Saturation douce surchantillonne dans le feedback (Delay / Multi-Tap)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "saturation", "Feedback Saturation", FeedbackSaturator<2>::getOversamplingNames(), 0));
+
+    // Gain de boucle ajout au feedback (au-del de 1), actif seulement avec
+    // la saturation : la courbe borne empche la boucle de diverger
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "overdrive", "Feedback Overdrive",
+        juce::NormalisableRange<float>(0.0f, 0.25f, 0.0f, 1.0f), 0.0f));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "wet", "Wet",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.0f, 1.0f), 0.35f));
@@ -37,6 +52,56 @@ SimpleReverbAudioProcessor::createParameterLayout()
         "roomSize", "Room Size",
         juce::NormalisableRange<float>(0.1f, 1.0f, 0.0f, 0.7f), 0.6f));
 
+    // Image stro du wet (mid/side) et balance de sortie, tous modes
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "width", "Stereo Width",
+        juce::NormalisableRange<float>(0.0f, 2.0f, 0.0f, 1.0f), 1.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "balance", "Balance",
+        juce::NormalisableRange<float>(-1.0f, 1.0f, 0.0f, 1.0f), 0.0f));
+
+    // Multiplicateurs du temps de dcroissance (T60 bande / T60 mdium).
+    // 1 = neutre : un tat sans ces paramtres garde un feedback plat en
+    // Delay et l'amortissement d'origine en Reverb (FdnReverb::naturalHighDecay)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "lowDecay", "Low Decay",
+        juce::NormalisableRange<float>(0.25f, 2.0f, 0.0f, 0.8f), 1.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "highDecay", "High Decay",
+        juce::NormalisableRange<float>(0.1f, 1.5f, 0.0f, 0.6f), 1.0f));
+
+    // Densit de la FDN (32 / 64 lignes : groupes rpartis sur des workers)
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "fdnLines", "Reverb Lines", FdnReverb::getLineCountNames(), 0));
+
+    // --- Multi-Tap : nombre de taps + division / gain / pan / envoi feedback par tap ---
+    params.push_back(std::make_unique<juce::AudioParameterInt>(
+        "tapCount", "Tap Count", 1, MultiTapDelay::maxTaps, 4));
+
+    for (int t = 0; t < MultiTapDelay::maxTaps; ++t)
+    {
+        const auto def = MultiTapDelay::getDefaultTap(t);
+        const juce::String name = "Tap " + juce::String(t + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            MultiTapDelay::paramId(t, "Division"), name + " Division",
+            MultiTapDelay::getDivisionNames(), def.division));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            MultiTapDelay::paramId(t, "Gain"), name + " Gain",
+            juce::NormalisableRange<float>(0.0f, 1.0f, 0.0f, 1.0f), def.gain));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            MultiTapDelay::paramId(t, "Pan"), name + " Pan",
+            juce::NormalisableRange<float>(-1.0f, 1.0f, 0.0f, 1.0f), def.pan));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            MultiTapDelay::paramId(t, "Feedback"), name + " Feedback",
+            juce::NormalisableRange<float>(0.0f, 1.0f, 0.0f, 1.0f), def.feedback));
+    }
+
     return { params.begin(), params.end() };
 }
 
@@ -56,9 +121,42 @@ SimpleReverbAudioProcessor::SimpleReverbAudioProcessor()
     )
 #endif
 {
+    // Rsolution des paramtres une fois pour toutes : pas de recherche par
+    // nom (ni de juce::String temporaire) sur le thread audio
+    paramPtrs.mode = apvts.getRawParameterValue("mode");
+    paramPtrs.delayType = apvts.getRawParameterValue("delayType");
+    paramPtrs.delayTimeMs = apvts.getRawParameterValue("delayTimeMs");
+    paramPtrs.feedback = apvts.getRawParameterValue("feedback");
+    paramPtrs.saturation = apvts.getRawParameterValue("saturation");
+    paramPtrs.overdrive = apvts.getRawParameterValue("overdrive");
+    paramPtrs.wet = apvts.getRawParameterValue("wet");
+    paramPtrs.roomSize = apvts.getRawParameterValue("roomSize");
+    paramPtrs.width = apvts.getRawParameterValue("width");
+    paramPtrs.balance = apvts.getRawParameterValue("balance");
+    paramPtrs.lowDecay = apvts.getRawParameterValue("lowDecay");
+    paramPtrs.highDecay = apvts.getRawParameterValue("highDecay");
+    paramPtrs.fdnLines = apvts.getRawParameterValue("fdnLines");
+    paramPtrs.tapCount = apvts.getRawParameterValue("tapCount");
+
+    for (int t = 0; t < MultiTapDelay::maxTaps; ++t)
+    {
+        paramPtrs.tapDivision[t] = apvts.getRawParameterValue(MultiTapDelay::paramId(t, "Division"));
+        paramPtrs.tapGain[t] = apvts.getRawParameterValue(MultiTapDelay::paramId(t, "Gain"));
+        paramPtrs.tapPan[t] = apvts.getRawParameterValue(MultiTapDelay::paramId(t, "Pan"));
+        paramPtrs.tapFeedback[t] = apvts.getRawParameterValue(MultiTapDelay::paramId(t, "Feedback"));
+    }
+
+    lastConfig = readParameters();
+
+    apvts.addParameterListener("fdnLines", this);
+    startTimerHz(10);
 }
 
-SimpleReverbAudioProcessor::~SimpleReverbAudioProcessor() = default;
+SimpleReverbAudioProcessor::~SimpleReverbAudioProcessor()
+{
+    stopTimer();
+    apvts.removeParameterListener("fdnLines", this);
+}
 
 //==============================================================================
 // Infos gnrales
@@ -128,20 +226,96 @@ void SimpleReverbAudioProcessor::prepareToPlay(double sampleRate, int samplesPer
     delayBuffer.clear();
     delayWritePosition = 0;
 
-    // --- Paramtres init de la reverb ---
-    juce::Reverb::Parameters params;
+    // --- Filtres de dcroissance + saturation du delay ---
+    delayDecay.prepare(sampleRate);
+    lastDelayFeedback = lastLowDecay = lastHighDecay = -1.0f; // force le calcul des coefficients
+    delaySaturator.reset();
+
+    // --- Reverb FDN ---
+    reverb.prepare(sampleRate);
+    requestReverbWorkers(static_cast<int>(paramPtrs.fdnLines->load()), false);
+
+    FdnReverb::Parameters params;
     params.roomSize = 0.6f;
-    params.damping = 0.5f;
-    params.width = 1.0f;
     params.wetLevel = 0.3f;
     params.dryLevel = 0.7f;
-    params.freezeMode = 0.0f;
     reverb.setParameters(params);
+
+    // --- Multi-Tap ---
+    multiTap.prepare(sampleRate, samplesPerBlock);
+
+    // --- Etat / presets ---
+    configExchange.collectGarbage();
+    lastConfig = readParameters();
+    morphRemaining = 0;
 }
 
 void SimpleReverbAudioProcessor::releaseResources()
 {
-    // Rien de spcial  librer ici
+    // Configs retires par le thread audio
+    configExchange.collectGarbage();
+    requestReverbWorkers(-1, false);
+}
+
+//==============================================================================
+// Workers de la FDN
+//==============================================================================
+
+void SimpleReverbAudioProcessor::requestReverbWorkers(int linesIndex, bool onlyIfActive) noexcept
+{
+    // Aucun lock ni message post : appelable depuis le thread audio
+    if (onlyIfActive)
+    {
+        int current = requestedWorkerLines.load();
+
+        while (current >= 0 && !requestedWorkerLines.compare_exchange_weak(current, linesIndex))
+        {
+        }
+    }
+    else
+    {
+        requestedWorkerLines.store(linesIndex);
+    }
+
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        applyReverbWorkers();
+}
+
+void SimpleReverbAudioProcessor::applyReverbWorkers()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const int linesIndex = requestedWorkerLines.load();
+
+    if (linesIndex == appliedWorkerLines)
+        return;
+
+    appliedWorkerLines = linesIndex;
+
+    if (linesIndex < 0)
+    {
+        reverb.stopWorkers();
+        return;
+    }
+
+    // Un groupe de lignes par thread, le thread audio prend le premier
+    const int numGroups = FdnReverb::lineCountFromIndex(linesIndex) / FdnReverb::linesPerGroup;
+    const int numWorkers = juce::jlimit(0, juce::jmax(0, juce::SystemStats::getNumCpus() - 1), numGroups - 1);
+
+    reverb.startWorkers(numWorkers);
+}
+
+void SimpleReverbAudioProcessor::timerCallback()
+{
+    applyReverbWorkers();
+}
+
+void SimpleReverbAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    // Souvent appel depuis le thread audio (automation) : simple dpt de la
+    // demande, la FDN reste mono-thread le temps que le timer la relve
+    if (parameterID == "fdnLines")
+        requestReverbWorkers(static_cast<int>(newValue), true);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -170,9 +344,39 @@ bool SimpleReverbAudioProcessor::isBusesLayoutSupported(const BusesLayout& layou
 // Traitement audio : cest ici que la magie Delay/Reverb se fait !
 //==============================================================================
 
+DspConfig SimpleReverbAudioProcessor::readParameters() const noexcept
+{
+    DspConfig c;
+    c.mode = DspConfig::modeFromParameters(static_cast<int>(paramPtrs.mode->load()),
+                                           static_cast<int>(paramPtrs.delayType->load()));
+    c.delayTimeMs = paramPtrs.delayTimeMs->load();
+    c.feedback = paramPtrs.feedback->load();
+    c.saturation = static_cast<int>(paramPtrs.saturation->load());
+    c.overdrive = paramPtrs.overdrive->load();
+    c.wet = paramPtrs.wet->load();
+    c.roomSize = paramPtrs.roomSize->load();
+    c.width = paramPtrs.width->load();
+    c.balance = paramPtrs.balance->load();
+    c.lowDecay = paramPtrs.lowDecay->load();
+    c.highDecay = paramPtrs.highDecay->load();
+    c.fdnLines = static_cast<int>(paramPtrs.fdnLines->load());
+    c.tapCount = static_cast<int>(paramPtrs.tapCount->load());
+
+    for (int t = 0; t < MultiTapDelay::maxTaps; ++t)
+    {
+        c.taps[t].division = static_cast<int>(paramPtrs.tapDivision[t]->load());
+        c.taps[t].gain = paramPtrs.tapGain[t]->load();
+        c.taps[t].pan = paramPtrs.tapPan[t]->load();
+        c.taps[t].feedback = paramPtrs.tapFeedback[t]->load();
+    }
+
+    return c;
+}
+
 void SimpleReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     juce::MidiBuffer& midiMessages)
 {
+    SIMPLEREVERB_AUDIT_SCOPE
     juce::ScopedNoDenormals noDenormals;
     juce::ignoreUnused(midiMessages);
 
@@ -185,17 +389,61 @@ void SimpleReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         buffer.clear(ch, 0, numSamples);
 
     // Rcupration des paramtres
-    auto* modeParam = apvts.getRawParameterValue("mode");
-    auto* delayParam = apvts.getRawParameterValue("delayTimeMs");
-    auto* fbParam = apvts.getRawParameterValue("feedback");
-    auto* wetParam = apvts.getRawParameterValue("wet");
-    auto* roomParam = apvts.getRawParameterValue("roomSize");
-
-    const int   mode = static_cast<int>(*modeParam); // 0 = Delay, 1 = Reverb
-    const float delayMs = *delayParam;
-    const float feedback = *fbParam;
-    const float wet = *wetParam;
-    const float roomSize = *roomParam;
+    const DspConfig target = readParameters();
+
+    // Tempo de l'hte (Multi-Tap), on garde le dernier connu sinon
+    if (auto* playHead = getPlayHead())
+        if (auto position = playHead->getPosition())
+            if (auto bpm = position->getBpm())
+                hostBpm = *bpm;
+
+    // Nouvel tat publi par setStateInformation() : on part de la config
+    // courante et on fond vers la nouvelle
+    if (auto* incoming = configExchange.acquire())
+    {
+        morphFrom = lastConfig;
+        morphTo = *incoming;
+        morphLength = morphRemaining = juce::jmax(1, (int)(currentSampleRate * morphSeconds));
+    }
+
+    int start = 0;
+
+    while (morphRemaining > 0 && start < numSamples)
+    {
+        // t pris en fin de tranche : la dernire tranche atteint exactement
+        // t = 1, la config cible qui suit ne fait aucun saut
+        const int num = juce::jmin(morphChunk, morphRemaining, numSamples - start);
+        const float t = 1.0f - (float)(morphRemaining - num) / (float)morphLength;
+
+        lastConfig = DspConfig::morph(morphFrom, morphTo, t);
+        render(buffer, start, num, lastConfig);
+
+        start += num;
+        morphRemaining -= num;
+    }
+
+    if (start < numSamples)
+    {
+        lastConfig = target;
+        render(buffer, start, numSamples - start, target);
+    }
+}
+
+void SimpleReverbAudioProcessor::render(juce::AudioBuffer<float>& buffer, int startSample,
+    int numSamples, const DspConfig& config) noexcept
+{
+    const int totalNumInputChannels = getTotalNumInputChannels();
+    const int totalNumOutputChannels = getTotalNumOutputChannels();
+
+    const int   mode = config.mode;
+    const float delayMs = config.delayTimeMs;
+    const int   saturation = config.saturation;
+
+    const float feedback = config.feedback;
+    const float wet = config.wet;
+    const float roomSize = config.roomSize;
+    const float lowDecay = config.lowDecay;
+    const float highDecay = config.highDecay;
 
     const float dry = 1.0f - wet;
 
@@ -208,59 +456,147 @@ void SimpleReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         if (delayBufferSize == 0)
             return;
 
-        const int delayInSamples = juce::jlimit(1,
-            delayBufferSize - 1,
-            (int)(currentSampleRate * delayMs / 1000.0f));
+        auto toSamples = [this, delayBufferSize](float ms)
+            {
+                return juce::jlimit(1, delayBufferSize - 1, (int)(currentSampleRate * ms / 1000.0f));
+            };
+
+        // Chargement d'tat : fondu entre l'ancienne et la nouvelle position
+        // de lecture plutt qu'un saut du pointeur
+        const int delayInSamples = toSamples(delayMs);
+        const int previousDelayInSamples = toSamples(config.previousDelayTimeMs);
+        const float newWeight = config.delayCrossfade;
+        const float previousWeight = 1.0f - newWeight;
+
+        // L'overdrive ne s'ajoute qu'avec la saturation, en gain plat avant
+        // elle : les tagres restent calcules sur le feedback linaire
+        // (<= 0.95), gBande = g^(1 / mult) n'ayant de sens que pour g < 1
+        const float overdrive = saturation > 0 ? config.overdrive : 0.0f;
+        const float drive = feedback > 0.0f ? (feedback + overdrive) / feedback : 1.0f;
+
+        // Coefficients recalculs seulement si un paramtre de dcroissance bouge
+        if (feedback != lastDelayFeedback || lowDecay != lastLowDecay || highDecay != lastHighDecay)
+        {
+            const float gains[2] = { feedback, feedback };
+            delayDecay.setGains(gains, 2, lowDecay, highDecay);
+
+            lastDelayFeedback = feedback;
+            lastLowDecay = lowDecay;
+            lastHighDecay = highDecay;
+        }
+
+        delaySaturator.setOversampling(saturation);
+
+        // Boucle chantillon par chantillon, tous les canaux  la fois :
+        // le banc de filtres traite les canaux ensemble
+        const int numChannels = juce::jmin(totalNumInputChannels, 2);
+        const auto mix = StereoMix::make(dry, wet, config.width, config.balance);
+
+        float* channelData[2] = {};
+        float* delayData[2] = {};
 
-        for (int ch = 0; ch < totalNumInputChannels; ++ch)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            float* channelData = buffer.getWritePointer(ch);
-            float* delayData = delayBuffer.getWritePointer(ch);
+            channelData[ch] = buffer.getWritePointer(ch, startSample);
+            delayData[ch] = delayBuffer.getWritePointer(ch);
+        }
+
+        int writePos = delayWritePosition;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int readPos = (writePos - delayInSamples + delayBufferSize) % delayBufferSize;
+            const int previousReadPos = (writePos - previousDelayInSamples + delayBufferSize) % delayBufferSize;
 
-            int writePos = delayWritePosition;
+            float in[2] = {};
+            float delayed[2] = {};
+            float fed[2] = {};
 
-            for (int i = 0; i < numSamples; ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
             {
-                const int readPos = (writePos - delayInSamples + delayBufferSize) % delayBufferSize;
+                in[ch] = channelData[ch][i];
+                delayed[ch] = fed[ch] = delayData[ch][readPos] * newWeight
+                                      + delayData[ch][previousReadPos] * previousWeight;
+            }
 
-                const float inSample = channelData[i];
-                const float delayed = delayData[readPos];
+            // feedback : gain + tagres grave / aigu, overdrive, puis saturation
+            delayDecay.processSample(fed, numChannels);
 
-                // feedback
-                delayData[writePos] = inSample + delayed * feedback;
+            for (int ch = 0; ch < numChannels; ++ch)
+                fed[ch] *= drive;
 
-                // mix dry / wet
-                channelData[i] = inSample * dry + delayed * wet;
+            delaySaturator.processSample(fed, numChannels);
 
-                if (++writePos >= delayBufferSize)
-                    writePos = 0;
-            }
+            for (int ch = 0; ch < numChannels; ++ch)
+                delayData[ch][writePos] = in[ch] + fed[ch];
+
+            // mix dry / wet + largeur / balance
+            if (numChannels == 2)
+                mix.apply(in[0], in[1], delayed[0], delayed[1], channelData[0][i], channelData[1][i]);
+            else if (numChannels == 1)
+                channelData[0][i] = mix.applyMono(in[0], delayed[0], delayed[0]);
+
+            if (++writePos >= delayBufferSize)
+                writePos = 0;
         }
 
         delayWritePosition += numSamples;
         delayWritePosition %= delayBuffer.getNumSamples();
     }
     // ----------------------------
+    // MODE 2 : MULTI-TAP
+    // ----------------------------
+    else if (mode == 2)
+    {
+        // Les positions des taps ne sont recalcules que si tempo / taps changent
+        auto params = multiTap.getParameters();
+        params.numTaps = config.tapCount;
+        std::copy(std::begin(config.taps), std::end(config.taps), std::begin(params.taps));
+        params.bpm = hostBpm;
+        params.feedback = feedback;
+        params.overdrive = config.overdrive;
+        params.saturation = saturation;
+        params.lowDecay = lowDecay;
+        params.highDecay = highDecay;
+        params.wetLevel = wet;
+        params.dryLevel = dry;
+        params.width = config.width;
+        params.balance = config.balance;
+        multiTap.setParameters(params);
+
+        if (totalNumOutputChannels == 1)
+            multiTap.processMono(buffer.getWritePointer(0, startSample), numSamples);
+        else
+            multiTap.processStereo(buffer.getWritePointer(0, startSample),
+                buffer.getWritePointer(1, startSample),
+                numSamples);
+    }
+    // ----------------------------
     // MODE 1 : REVERB
     // ----------------------------
     else
     {
         // Mise  jour des paramtres de la reverb
         auto params = reverb.getParameters();
+        params.numLines = FdnReverb::lineCountFromIndex(config.fdnLines);
         params.roomSize = roomSize;
+        params.lowDecay = lowDecay;
+        params.highDecay = highDecay;
         params.wetLevel = wet;
         params.dryLevel = dry;
+        params.width = config.width;
+        params.balance = config.balance;
         reverb.setParameters(params);
 
         if (totalNumOutputChannels == 1)
         {
-            reverb.processMono(buffer.getWritePointer(0), numSamples);
+            reverb.processMono(buffer.getWritePointer(0, startSample), numSamples);
         }
         else
         {
             // On ne traite que les deux premiers canaux (classique pour une reverb)
-            reverb.processStereo(buffer.getWritePointer(0),
-                buffer.getWritePointer(1),
+            reverb.processStereo(buffer.getWritePointer(0, startSample),
+                buffer.getWritePointer(1, startSample),
                 numSamples);
         }
     }
@@ -296,7 +632,18 @@ void SimpleReverbAudioProcessor::setStateInformation(const void* data, int sizeI
     std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
 
     if (xml.get() != nullptr && xml->hasTagName(apvts.state.getType()))
-        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    {
+        auto state = juce::ValueTree::fromXml(*xml);
+
+        // Config complte construite ici (thread message), publie par change
+        // de pointeur : le thread audio fond vers elle sans allouer ni verrouiller.
+        // Publie avant replaceState pour que le fondu parte de l'ancienne config.
+        auto config = std::make_unique<DspConfig>(DspConfig::fromState(state, readParameters()));
+        requestReverbWorkers(config->fdnLines, true);
+        configExchange.publish(std::move(config));
+
+        apvts.replaceState(state);
+    }
 }
 
 //==============================================================================
@@ -8,12 +8,20 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AudioThreadAudit.h"
+#include "DecayFilterBank.h"
+#include "DspConfig.h"
+#include "FeedbackSaturator.h"
+#include "FdnReverb.h"
+#include "MultiTapDelay.h"
 
 //==============================================================================
 // Classe processeur : gre le traitement audio (DSP)
 //==============================================================================
 
-class SimpleReverbAudioProcessor : public juce::AudioProcessor
+class SimpleReverbAudioProcessor : public juce::AudioProcessor,
+                                   private juce::AudioProcessorValueTreeState::Listener,
+                                   private juce::Timer
 {
 public:
     //==========================================================================
@@ -62,16 +70,79 @@ public:
     APVTS apvts{ *this, nullptr, "PARAMS", createParameterLayout() };
 
 private:
+    //==========================================================================
+    // Paramtres ct thread audio
+
+    // Lecture des valeurs brutes (pointeurs rsolus une fois dans le constructeur)
+    DspConfig readParameters() const noexcept;
+
+    // Workers FDN : (re)lancs uniquement sur le thread message. Les autres
+    // threads (automation sur le thread audio, prepareToPlay / chargement
+    // d'tat appels ailleurs par l'hte) dposent la demande, releve par le
+    // timer. linesIndex = -1 : arrt ; onlyIfActive : ignore aprs
+    // releaseResources()
+    void requestReverbWorkers(int linesIndex, bool onlyIfActive) noexcept;
+    void applyReverbWorkers();
+    void timerCallback() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    std::atomic<int> requestedWorkerLines{ -1 };
+    int appliedWorkerLines = -1;               // thread message uniquement
+
+    struct ParameterPointers
+    {
+        std::atomic<float>* mode = nullptr;
+        std::atomic<float>* delayType = nullptr;
+        std::atomic<float>* delayTimeMs = nullptr;
+        std::atomic<float>* feedback = nullptr;
+        std::atomic<float>* saturation = nullptr;
+        std::atomic<float>* overdrive = nullptr;
+        std::atomic<float>* wet = nullptr;
+        std::atomic<float>* roomSize = nullptr;
+        std::atomic<float>* width = nullptr;
+        std::atomic<float>* balance = nullptr;
+        std::atomic<float>* lowDecay = nullptr;
+        std::atomic<float>* highDecay = nullptr;
+        std::atomic<float>* fdnLines = nullptr;
+        std::atomic<float>* tapCount = nullptr;
+        std::atomic<float>* tapDivision[MultiTapDelay::maxTaps] = {};
+        std::atomic<float>* tapGain[MultiTapDelay::maxTaps] = {};
+        std::atomic<float>* tapPan[MultiTapDelay::maxTaps] = {};
+        std::atomic<float>* tapFeedback[MultiTapDelay::maxTaps] = {};
+    } paramPtrs;
+
+    // Chargement d'tat : config publie par le thread message, puis fondu
+    // de l'ancienne vers la nouvelle sur morphSeconds, par tranches de morphChunk
+    static constexpr double morphSeconds = 0.05;
+    static constexpr int morphChunk = 32;
+
+    DspConfigExchange configExchange;
+    DspConfig lastConfig, morphFrom, morphTo;
+    int morphLength = 0, morphRemaining = 0;
+
     //==========================================================================
     // DSP interne
+    void render(juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+        const DspConfig& config) noexcept;
 
     // --- Delay ---
     double currentSampleRate = 44100.0;
     juce::AudioBuffer<float> delayBuffer;  // buffer circulaire pour le delay
     int delayWritePosition = 0;
 
-    // --- Reverb JUCE ---
-    juce::Reverb reverb;
+    // Filtres de dcroissance dans le feedback du delay (un par canal)
+    DecayFilterBank<2> delayDecay;
+    float lastDelayFeedback = -1.0f, lastLowDecay = -1.0f, lastHighDecay = -1.0f;
+
+    // Saturation surchantillonne aprs les filtres
+    FeedbackSaturator<2> delaySaturator;
+
+    // --- Reverb FDN ---
+    FdnReverb reverb;
+
+    // --- Multi-Tap ---
+    MultiTapDelay multiTap;
+    double hostBpm = 120.0;    // tempo lu dans le playhead  chaque bloc
 
     //==========================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimpleReverbAudioProcessor)
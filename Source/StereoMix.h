@@ -0,0 +1,62 @@
+﻿/*
+  ==============================================================================
+    StereoMix.h
+    SimpleDelayReverbFDN – mix de sortie : dry / wet, largeur, balance
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Matrice de sortie 2x2 appliquée dans la boucle de mix de chaque mode :
+// dry / wet, largeur stéréo du wet et balance en une seule passe.
+//
+// Largeur en mid/side sur le wet : M = (L + R) / 2, S = width * (L - R) / 2,
+// soit L' = a L + b R et R' = b L + a R avec a = (1 + width) / 2,
+// b = (1 - width) / 2 (0 = mono, 1 = inchangé, 2 = élargi).
+//
+// Balance linéaire sur la sortie : seul le côté opposé est atténué, le
+// centre reste à gain unité.
+//==============================================================================
+struct StereoMix
+{
+    float dryL = 1.0f, dryR = 1.0f;
+    float wetLL = 0.0f, wetLR = 0.0f, wetRL = 0.0f, wetRR = 0.0f;
+    float dryMono = 1.0f, wetMono = 0.0f;
+
+    static StereoMix make(float dry, float wet, float width, float balance) noexcept
+    {
+        const float a = 0.5f * (1.0f + width);
+        const float b = 0.5f * (1.0f - width);
+
+        const float gainL = juce::jmin(1.0f, 1.0f - balance);
+        const float gainR = juce::jmin(1.0f, 1.0f + balance);
+
+        StereoMix m;
+        m.dryL = dry * gainL;
+        m.dryR = dry * gainR;
+        m.wetLL = wet * a * gainL;
+        m.wetLR = wet * b * gainL;
+        m.wetRL = wet * b * gainR;
+        m.wetRR = wet * a * gainR;
+
+        // Mono : ni largeur ni balance, moyenne des deux sorties wet
+        m.dryMono = dry;
+        m.wetMono = 0.5f * wet;
+        return m;
+    }
+
+    //==========================================================================
+    void apply(float inL, float inR, float wetL, float wetR, float& outL, float& outR) const noexcept
+    {
+        outL = inL * dryL + wetL * wetLL + wetR * wetLR;
+        outR = inR * dryR + wetL * wetRL + wetR * wetRR;
+    }
+
+    float applyMono(float in, float wetL, float wetR) const noexcept
+    {
+        return in * dryMono + (wetL + wetR) * wetMono;
+    }
+};